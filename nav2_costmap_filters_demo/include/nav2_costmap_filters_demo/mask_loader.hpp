@@ -0,0 +1,107 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_FILTERS_DEMO__MASK_LOADER_HPP_
+#define NAV2_COSTMAP_FILTERS_DEMO__MASK_LOADER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "nav_msgs/msg/occupancy_grid.hpp"
+
+namespace nav2_costmap_filters_demo
+{
+
+// Same interpretation modes as the nav2_map_server
+enum class MaskMode
+{
+  Trinary,
+  Scale,
+  Raw
+};
+
+// Contents of a map_server compatible mask yaml file
+struct MaskParameters
+{
+  std::string image_file_name;
+  double resolution{0.0};
+  std::vector<double> origin{0.0, 0.0, 0.0};
+  double free_thresh{0.25};
+  double occupied_thresh{0.65};
+  MaskMode mode{MaskMode::Trinary};
+  bool negate{false};
+};
+
+// Pixel value to OccupancyGrid value conversion table
+using MaskLut = std::array<int8_t, 256>;
+
+// Parses the mask yaml file. The image path is resolved relative to the yaml.
+// Throws std::runtime_error on missing or invalid fields.
+MaskParameters loadMaskYaml(const std::string & yaml_filename);
+
+// Precomputes the per-pixel threshold logic of the map_server for every
+// possible 8-bit pixel value of an image with given maximum value.
+MaskLut buildMaskLut(const MaskParameters & params, unsigned int max_value);
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string & filename);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const uint8_t * data() const {return data_;}
+  size_t size() const {return size_;}
+
+private:
+  const uint8_t * data_{nullptr};
+  size_t size_{0};
+};
+
+// Binary (P5) 8-bit PGM image, pixels are read directly from the mapped file
+class PgmImage
+{
+public:
+  // Throws std::runtime_error if the file is not an 8-bit binary PGM
+  explicit PgmImage(const std::string & filename);
+
+  unsigned int width() const {return width_;}
+  unsigned int height() const {return height_;}
+  unsigned int maxValue() const {return max_value_;}
+
+  // Row-major pixels, first row is the top of the image
+  const uint8_t * pixels() const {return pixels_;}
+
+private:
+  MappedFile file_;
+  unsigned int width_{0};
+  unsigned int height_{0};
+  unsigned int max_value_{0};
+  const uint8_t * pixels_{nullptr};
+};
+
+// Fills msg info and data with the mask described by params. The image is
+// converted in a single pass through the LUT straight into msg.data.
+// Throws std::runtime_error on failure.
+void loadMask(const MaskParameters & params, nav_msgs::msg::OccupancyGrid & msg);
+
+}  // namespace nav2_costmap_filters_demo
+
+#endif  // NAV2_COSTMAP_FILTERS_DEMO__MASK_LOADER_HPP_
@@ -0,0 +1,99 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_FILTERS_DEMO__MASK_PYRAMID_HPP_
+#define NAV2_COSTMAP_FILTERS_DEMO__MASK_PYRAMID_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "nav_msgs/msg/occupancy_grid.hpp"
+
+namespace nav2_costmap_filters_demo
+{
+
+// Min/max mipmap of a filter mask, built once when the mask is loaded.
+// Every level halves the resolution of the previous one, storing the minimum
+// and maximum of the known (non-negative) mask values of each 2x2 block.
+// Region queries descend from the top level and refine only the blocks
+// crossing the rectangle border, so large areas are answered by a handful
+// of coarse blocks instead of a scan over every mask cell, independently of
+// the resolution the consumer works at.
+class MaskPyramid
+{
+public:
+  MaskPyramid() = default;
+
+  // Builds the pyramid over mask; level 0 references the mask data directly
+  void build(std::shared_ptr<const nav_msgs::msg::OccupancyGrid> mask);
+
+  // Releases the mask and all levels
+  void clear();
+
+  bool empty() const {return !mask_;}
+
+  // Number of levels including the full resolution one
+  unsigned int levels() const {return static_cast<unsigned int>(levels_.size()) + 1;}
+
+  // Minimum and maximum known mask value in the world rectangle (mask frame).
+  // Returns false if the rectangle has no known mask cell.
+  bool queryRegion(
+    double min_x, double min_y, double max_x, double max_y,
+    int8_t & min_value, int8_t & max_value) const;
+
+  // Same as queryRegion() for an inclusive cell rectangle
+  bool queryCells(
+    unsigned int min_i, unsigned int min_j, unsigned int max_i, unsigned int max_j,
+    int8_t & min_value, int8_t & max_value) const;
+
+  // Whether any mask cell in the world rectangle has a value >= threshold,
+  // e.g. "is any cell in this rectangle keepout?". Stops at the first hit.
+  bool anyAtLeast(
+    double min_x, double min_y, double max_x, double max_y, int8_t threshold) const;
+
+private:
+  struct Level
+  {
+    unsigned int width;
+    unsigned int height;
+    std::vector<int8_t> min;
+    std::vector<int8_t> max;
+  };
+
+  // Clamps a world rectangle to inclusive mask cell bounds, false if outside the mask
+  bool worldToCells(
+    double min_x, double min_y, double max_x, double max_y,
+    unsigned int & min_i, unsigned int & min_j,
+    unsigned int & max_i, unsigned int & max_j) const;
+
+  // Min/max of block (i, j) at given level, level 0 being the mask itself
+  void block(
+    unsigned int level, unsigned int i, unsigned int j,
+    int8_t & min_value, int8_t & max_value) const;
+
+  // Shared quadtree descent: with stop_threshold set, returns as soon as a block
+  // with max >= stop_threshold is fully inside the rectangle
+  bool descend(
+    unsigned int min_i, unsigned int min_j, unsigned int max_i, unsigned int max_j,
+    int8_t & min_value, int8_t & max_value, const int8_t * stop_threshold) const;
+
+  std::shared_ptr<const nav_msgs::msg::OccupancyGrid> mask_;
+  // Coarser levels, levels_[0] being the first 2x2 reduction of the mask
+  std::vector<Level> levels_;
+};
+
+}  // namespace nav2_costmap_filters_demo
+
+#endif  // NAV2_COSTMAP_FILTERS_DEMO__MASK_PYRAMID_HPP_
@@ -0,0 +1,85 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_FILTERS_DEMO__MASK_SERVER_HPP_
+#define NAV2_COSTMAP_FILTERS_DEMO__MASK_SERVER_HPP_
+
+#include <memory>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_util/lifecycle_node.hpp"
+#include "nav_msgs/msg/occupancy_grid.hpp"
+#include "tf2_ros/buffer.h"
+#include "tf2_ros/transform_listener.h"
+#include "nav2_costmap_filters_demo/mask_pyramid.hpp"
+#include "nav2_costmap_filters_demo/tiled_mask.hpp"
+#include "nav2_costmap_filters_demo/srv/query_mask_region.hpp"
+
+namespace nav2_costmap_filters_demo
+{
+
+// Drop-in replacement of the nav2_map_server used as filter_mask_server.
+// Uses the same yaml_filename, topic_name and frame_id parameters, but loads
+// binary PGM masks through a memory mapping and a precomputed LUT.
+// Optionally builds a min/max pyramid of the mask at load time and answers
+// rectangle queries on the ~/query_region service.
+// Masks whose image is a tiled mask (see mask_tiler) are never loaded whole:
+// a rolling window around the robot is paged in and republished as it moves.
+class MaskServer : public nav2_util::LifecycleNode
+{
+public:
+  explicit MaskServer(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+  ~MaskServer();
+
+protected:
+  nav2_util::CallbackReturn on_configure(const rclcpp_lifecycle::State & state) override;
+  nav2_util::CallbackReturn on_activate(const rclcpp_lifecycle::State & state) override;
+  nav2_util::CallbackReturn on_deactivate(const rclcpp_lifecycle::State & state) override;
+  nav2_util::CallbackReturn on_cleanup(const rclcpp_lifecycle::State & state) override;
+  nav2_util::CallbackReturn on_shutdown(const rclcpp_lifecycle::State & state) override;
+
+  // Republishes the tiled mask window if the robot left its center
+  void updateWindow();
+
+  // Min/max of the mask values inside the requested rectangle
+  void queryRegionCallback(
+    const std::shared_ptr<srv::QueryMaskRegion::Request> request,
+    std::shared_ptr<srv::QueryMaskRegion::Response> response);
+
+  // Loaded mask (or current window of a tiled mask), published as is
+  std::shared_ptr<nav_msgs::msg::OccupancyGrid> mask_;
+  std::string frame_id_;
+
+  rclcpp_lifecycle::LifecyclePublisher<nav_msgs::msg::OccupancyGrid>::SharedPtr mask_pub_;
+
+  // Region queries over the loaded mask
+  bool build_pyramid_;
+  MaskPyramid pyramid_;
+  rclcpp::Service<srv::QueryMaskRegion>::SharedPtr query_region_service_;
+
+  // Tiled mask paging
+  std::unique_ptr<TiledMask> tiled_mask_;
+  std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
+  std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
+  rclcpp::TimerBase::SharedPtr window_timer_;
+  std::string robot_base_frame_;
+  double window_size_;
+  // Center of the last published window
+  double window_x_, window_y_;
+};
+
+}  // namespace nav2_costmap_filters_demo
+
+#endif  // NAV2_COSTMAP_FILTERS_DEMO__MASK_SERVER_HPP_
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NAV2_COSTMAP_FILTERS_DEMO__TILED_MASK_HPP_
+#define NAV2_COSTMAP_FILTERS_DEMO__TILED_MASK_HPP_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "nav_msgs/msg/occupancy_grid.hpp"
+#include "nav2_costmap_filters_demo/mask_loader.hpp"
+
+namespace nav2_costmap_filters_demo
+{
+
+// Extension of the tiled mask files, used in place of the PGM in mask yamls
+constexpr char TILED_MASK_EXTENSION[] = ".tmask";
+
+// Header of a tiled mask file. The header is followed by tiles_x * tiles_y
+// square tiles stored row by row, bottom tile row first. Each tile holds
+// tile_size * tile_size OccupancyGrid values (already converted through the
+// mask LUT), in grid order; tiles crossing the mask border are padded with -1.
+struct TiledMaskHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t tile_size;
+  uint32_t width;
+  uint32_t height;
+  uint32_t tiles_x;
+  uint32_t tiles_y;
+  double resolution;
+  double origin_x;
+  double origin_y;
+  uint64_t data_offset;
+};
+
+// Converts a PGM mask into a tiled mask file, one tile row at a time so the
+// memory used does not depend on the mask size.
+// Throws std::runtime_error on failure.
+void writeTiledMask(
+  const MaskParameters & params, unsigned int tile_size, const std::string & filename);
+
+// Tiled mask reader paging tiles in on demand. At most max_tiles tiles are
+// kept in memory, the least recently used one being evicted first.
+class TiledMask
+{
+public:
+  // Throws std::runtime_error if the file is not a valid tiled mask
+  TiledMask(const std::string & filename, size_t max_tiles);
+  ~TiledMask();
+
+  TiledMask(const TiledMask &) = delete;
+  TiledMask & operator=(const TiledMask &) = delete;
+
+  const TiledMaskHeader & header() const {return header_;}
+
+  // Number of tiles a size_x * size_y meters window may overlap
+  size_t tilesForWindow(double size_x, double size_y) const;
+
+  // Fills msg info and data with the size_x * size_y meters window centered
+  // at (x, y), snapped to the mask cells. Cells outside the mask are unknown.
+  // The cache capacity is raised if the window needs more than max_tiles.
+  void getWindow(
+    double x, double y, double size_x, double size_y, nav_msgs::msg::OccupancyGrid & msg);
+
+private:
+  // Tile data, read from the file if not cached
+  const int8_t * tile(uint32_t tx, uint32_t ty);
+
+  int fd_;
+  TiledMaskHeader header_;
+  size_t max_tiles_;
+
+  // Most recently used tile first
+  std::list<uint64_t> lru_;
+  struct CachedTile
+  {
+    std::list<uint64_t>::iterator lru_position;
+    std::vector<int8_t> data;
+  };
+  std::unordered_map<uint64_t, CachedTile> cache_;
+};
+
+}  // namespace nav2_costmap_filters_demo
+
+#endif  // NAV2_COSTMAP_FILTERS_DEMO__TILED_MASK_HPP_
@@ -44,6 +44,17 @@ def generate_launch_description():
     use_composition = LaunchConfiguration('use_composition')
     container_name = LaunchConfiguration('container_name')
     container_name_full = (namespace, '/', container_name)
+    use_native_mask_server = LaunchConfiguration('use_native_mask_server')
+
+    # The native mask server is a drop-in replacement of the map_server for filter masks
+    mask_server_package = PythonExpression([
+        "'nav2_costmap_filters_demo' if ", use_native_mask_server,
+        " else 'nav2_map_server'"])
+    mask_server_executable = PythonExpression([
+        "'mask_server' if ", use_native_mask_server, " else 'map_server'"])
+    mask_server_plugin = PythonExpression([
+        "'nav2_costmap_filters_demo::MaskServer' if ", use_native_mask_server,
+        " else 'nav2_map_server::MapServer'"])
 
     # Declare the launch arguments
     declare_namespace_cmd = DeclareLaunchArgument(
@@ -76,6 +87,11 @@ def generate_launch_description():
         'container_name', default_value='nav2_container',
         description='The name of container that nodes will load in if use composition')
 
+    declare_use_native_mask_server_cmd = DeclareLaunchArgument(
+        'use_native_mask_server', default_value='False',
+        description='Load the filter mask with the mmap-based mask server of this package '
+                    '(required for tiled .tmask masks)')
+
     # Make re-written yaml
     param_substitutions = {
         'use_sim_time': use_sim_time,
@@ -91,8 +107,8 @@ def generate_launch_description():
         condition=IfCondition(PythonExpression(['not ', use_composition])),
         actions=[
             Node(
-                package='nav2_map_server',
-                executable='map_server',
+                package=mask_server_package,
+                executable=mask_server_executable,
                 name='filter_mask_server',
                 namespace=namespace,
                 output='screen',
@@ -129,8 +145,8 @@ def generate_launch_description():
                 target_container=container_name_full,
                 composable_node_descriptions=[
                     ComposableNode(
-                        package='nav2_map_server',
-                        plugin='nav2_map_server::MapServer',
+                        package=mask_server_package,
+                        plugin=mask_server_plugin,
                         name='filter_mask_server',
                         parameters=[configured_params]),
                     ComposableNode(
@@ -160,6 +176,7 @@ def generate_launch_description():
 
     ld.add_action(declare_use_composition_cmd)
     ld.add_action(declare_container_name_cmd)
+    ld.add_action(declare_use_native_mask_server_cmd)
 
     ld.add_action(load_nodes)
     ld.add_action(load_composable_nodes)
@@ -0,0 +1,270 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_filters_demo/mask_loader.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+namespace nav2_costmap_filters_demo
+{
+
+namespace
+{
+
+constexpr int8_t OCC_GRID_UNKNOWN = -1;
+constexpr int8_t OCC_GRID_FREE = 0;
+constexpr int8_t OCC_GRID_OCCUPIED = 100;
+
+template<typename T>
+T yamlGetValue(const YAML::Node & node, const std::string & key)
+{
+  try {
+    return node[key].as<T>();
+  } catch (YAML::Exception & e) {
+    throw std::runtime_error(
+            "Failed to parse mask YAML tag '" + key + "' for reason: " + e.msg);
+  }
+}
+
+// Skips whitespace and '#' comments of a PGM header
+size_t skipPgmSeparators(const uint8_t * data, size_t size, size_t pos)
+{
+  while (pos < size) {
+    if (data[pos] == '#') {
+      while (pos < size && data[pos] != '\n') {
+        ++pos;
+      }
+    } else if (std::isspace(data[pos])) {
+      ++pos;
+    } else {
+      break;
+    }
+  }
+  return pos;
+}
+
+unsigned int readPgmNumber(const uint8_t * data, size_t size, size_t & pos)
+{
+  pos = skipPgmSeparators(data, size, pos);
+  if (pos >= size || !std::isdigit(data[pos])) {
+    throw std::runtime_error("Malformed PGM header");
+  }
+  unsigned long value = 0;  // NOLINT
+  while (pos < size && std::isdigit(data[pos])) {
+    value = value * 10 + (data[pos] - '0');
+    if (value > 0xFFFFFFFFul) {
+      throw std::runtime_error("Malformed PGM header");
+    }
+    ++pos;
+  }
+  return static_cast<unsigned int>(value);
+}
+
+}  // namespace
+
+MaskParameters loadMaskYaml(const std::string & yaml_filename)
+{
+  YAML::Node doc;
+  try {
+    doc = YAML::LoadFile(yaml_filename);
+  } catch (YAML::Exception & e) {
+    throw std::runtime_error("Failed to load mask YAML " + yaml_filename + ": " + e.msg);
+  }
+
+  MaskParameters params;
+  params.image_file_name = yamlGetValue<std::string>(doc, "image");
+  if (params.image_file_name.empty()) {
+    throw std::runtime_error("The image tag in " + yaml_filename + " is empty");
+  }
+  if (params.image_file_name[0] != '/') {
+    const size_t slash = yaml_filename.find_last_of('/');
+    if (slash != std::string::npos) {
+      params.image_file_name = yaml_filename.substr(0, slash + 1) + params.image_file_name;
+    }
+  }
+
+  params.resolution = yamlGetValue<double>(doc, "resolution");
+  params.origin = yamlGetValue<std::vector<double>>(doc, "origin");
+  if (params.origin.size() != 3) {
+    throw std::runtime_error("Value of the 'origin' tag should have 3 elements");
+  }
+  params.free_thresh = yamlGetValue<double>(doc, "free_thresh");
+  params.occupied_thresh = yamlGetValue<double>(doc, "occupied_thresh");
+
+  const std::string mode = doc["mode"] ? yamlGetValue<std::string>(doc, "mode") : "trinary";
+  if (mode == "trinary") {
+    params.mode = MaskMode::Trinary;
+  } else if (mode == "scale") {
+    params.mode = MaskMode::Scale;
+  } else if (mode == "raw") {
+    params.mode = MaskMode::Raw;
+  } else {
+    throw std::runtime_error("Unknown mask mode '" + mode + "'");
+  }
+
+  params.negate = yamlGetValue<int>(doc, "negate") != 0;
+  return params;
+}
+
+MaskLut buildMaskLut(const MaskParameters & params, unsigned int max_value)
+{
+  MaskLut lut;
+  lut.fill(OCC_GRID_UNKNOWN);
+
+  for (unsigned int pixel = 0; pixel <= max_value && pixel < lut.size(); ++pixel) {
+    // On a scale from 0.0 to 1.0 how bright the pixel is
+    const double shade = static_cast<double>(pixel) / max_value;
+    // On a scale from 0.0 to 1.0 how occupied the mask cell should be
+    const double occ = params.negate ? shade : 1.0 - shade;
+
+    int8_t value = OCC_GRID_UNKNOWN;
+    switch (params.mode) {
+      case MaskMode::Trinary:
+        if (params.occupied_thresh < occ) {
+          value = OCC_GRID_OCCUPIED;
+        } else if (occ < params.free_thresh) {
+          value = OCC_GRID_FREE;
+        }
+        break;
+      case MaskMode::Scale:
+        if (params.occupied_thresh < occ) {
+          value = OCC_GRID_OCCUPIED;
+        } else if (occ < params.free_thresh) {
+          value = OCC_GRID_FREE;
+        } else {
+          value = static_cast<int8_t>(
+            std::rint(
+              (occ - params.free_thresh) /
+              (params.occupied_thresh - params.free_thresh) * 100.0));
+        }
+        break;
+      case MaskMode::Raw:
+        {
+          const double occ_percent = std::round(shade * 255);
+          if (OCC_GRID_FREE <= occ_percent && occ_percent <= OCC_GRID_OCCUPIED) {
+            value = static_cast<int8_t>(occ_percent);
+          }
+          break;
+        }
+    }
+    lut[pixel] = value;
+  }
+
+  return lut;
+}
+
+MappedFile::MappedFile(const std::string & filename)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open " + filename + ": " + std::strerror(errno));
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("Failed to stat " + filename + " or file is empty");
+  }
+  size_ = static_cast<size_t>(st.st_size);
+
+  void * addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (addr == MAP_FAILED) {
+    throw std::runtime_error("Failed to mmap " + filename + ": " + std::strerror(errno));
+  }
+  // Masks are converted front to back exactly once
+  madvise(addr, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const uint8_t *>(addr);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_) {
+    munmap(const_cast<uint8_t *>(data_), size_);
+  }
+}
+
+PgmImage::PgmImage(const std::string & filename)
+: file_(filename)
+{
+  const uint8_t * data = file_.data();
+  const size_t size = file_.size();
+
+  if (size < 2 || data[0] != 'P' || data[1] != '5') {
+    throw std::runtime_error(filename + " is not a binary (P5) PGM image");
+  }
+
+  size_t pos = 2;
+  width_ = readPgmNumber(data, size, pos);
+  height_ = readPgmNumber(data, size, pos);
+  max_value_ = readPgmNumber(data, size, pos);
+  if (width_ == 0 || height_ == 0 || max_value_ == 0 || max_value_ > 255) {
+    throw std::runtime_error(filename + " is not an 8-bit PGM image");
+  }
+
+  // Exactly one whitespace character separates the header from the raster
+  ++pos;
+  if (pos > size || size - pos < static_cast<size_t>(width_) * height_) {
+    throw std::runtime_error(filename + " is truncated");
+  }
+  pixels_ = data + pos;
+}
+
+void loadMask(const MaskParameters & params, nav_msgs::msg::OccupancyGrid & msg)
+{
+  PgmImage image(params.image_file_name);
+  const MaskLut lut = buildMaskLut(params, image.maxValue());
+
+  const size_t width = image.width();
+  const size_t height = image.height();
+
+  msg.info.width = image.width();
+  msg.info.height = image.height();
+  msg.info.resolution = params.resolution;
+  msg.info.origin.position.x = params.origin[0];
+  msg.info.origin.position.y = params.origin[1];
+  msg.info.origin.position.z = 0.0;
+  msg.info.origin.orientation.x = 0.0;
+  msg.info.origin.orientation.y = 0.0;
+  msg.info.origin.orientation.z = std::sin(params.origin[2] / 2.0);
+  msg.info.origin.orientation.w = std::cos(params.origin[2] / 2.0);
+
+  // Image rows go top to bottom while the grid rows go bottom to top
+  msg.data.resize(width * height);
+  const uint8_t * pixels = image.pixels();
+  int8_t * cells = msg.data.data();
+  for (size_t y = 0; y < height; ++y) {
+    const uint8_t * src = pixels + y * width;
+    int8_t * dst = cells + (height - y - 1) * width;
+    for (size_t x = 0; x < width; ++x) {
+      dst[x] = lut[src[x]];
+    }
+  }
+}
+
+}  // namespace nav2_costmap_filters_demo
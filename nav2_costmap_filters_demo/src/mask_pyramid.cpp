@@ -0,0 +1,233 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_filters_demo/mask_pyramid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace nav2_costmap_filters_demo
+{
+
+namespace
+{
+
+// Min/max of a block without any known cell
+constexpr int8_t NO_MIN = std::numeric_limits<int8_t>::max();
+constexpr int8_t NO_MAX = -1;
+
+}  // namespace
+
+void MaskPyramid::build(std::shared_ptr<const nav_msgs::msg::OccupancyGrid> mask)
+{
+  clear();
+  if (!mask || mask->info.width == 0 || mask->info.height == 0) {
+    return;
+  }
+  mask_ = std::move(mask);
+
+  unsigned int width = mask_->info.width;
+  unsigned int height = mask_->info.height;
+  unsigned int level = 0;
+  while (width > 1 || height > 1) {
+    Level next;
+    next.width = (width + 1) / 2;
+    next.height = (height + 1) / 2;
+    next.min.assign(static_cast<size_t>(next.width) * next.height, NO_MIN);
+    next.max.assign(static_cast<size_t>(next.width) * next.height, NO_MAX);
+
+    // Reduce the previous level row by row, each source cell is read once
+    for (unsigned int j = 0; j < height; ++j) {
+      const size_t dst_row = static_cast<size_t>(j / 2) * next.width;
+      for (unsigned int i = 0; i < width; ++i) {
+        int8_t block_min, block_max;
+        block(level, i, j, block_min, block_max);
+        const size_t dst = dst_row + i / 2;
+        next.min[dst] = std::min(next.min[dst], block_min);
+        next.max[dst] = std::max(next.max[dst], block_max);
+      }
+    }
+
+    width = next.width;
+    height = next.height;
+    levels_.push_back(std::move(next));
+    ++level;
+  }
+}
+
+void MaskPyramid::clear()
+{
+  mask_.reset();
+  levels_.clear();
+}
+
+void MaskPyramid::block(
+  unsigned int level, unsigned int i, unsigned int j,
+  int8_t & min_value, int8_t & max_value) const
+{
+  if (level == 0) {
+    const int8_t value = mask_->data[static_cast<size_t>(j) * mask_->info.width + i];
+    min_value = value < 0 ? NO_MIN : value;
+    max_value = value < 0 ? NO_MAX : value;
+    return;
+  }
+
+  const Level & l = levels_[level - 1];
+  const size_t index = static_cast<size_t>(j) * l.width + i;
+  min_value = l.min[index];
+  max_value = l.max[index];
+}
+
+bool MaskPyramid::worldToCells(
+  double min_x, double min_y, double max_x, double max_y,
+  unsigned int & min_i, unsigned int & min_j,
+  unsigned int & max_i, unsigned int & max_j) const
+{
+  if (!mask_) {
+    return false;
+  }
+
+  const auto & info = mask_->info;
+  const double x0 = std::floor((min_x - info.origin.position.x) / info.resolution);
+  const double y0 = std::floor((min_y - info.origin.position.y) / info.resolution);
+  const double x1 = std::floor((max_x - info.origin.position.x) / info.resolution);
+  const double y1 = std::floor((max_y - info.origin.position.y) / info.resolution);
+  if (x1 < 0.0 || y1 < 0.0 || x0 >= info.width || y0 >= info.height || x0 > x1 || y0 > y1) {
+    return false;
+  }
+
+  min_i = static_cast<unsigned int>(std::max(x0, 0.0));
+  min_j = static_cast<unsigned int>(std::max(y0, 0.0));
+  max_i = static_cast<unsigned int>(std::min(x1, info.width - 1.0));
+  max_j = static_cast<unsigned int>(std::min(y1, info.height - 1.0));
+  return true;
+}
+
+bool MaskPyramid::queryRegion(
+  double min_x, double min_y, double max_x, double max_y,
+  int8_t & min_value, int8_t & max_value) const
+{
+  unsigned int min_i, min_j, max_i, max_j;
+  if (!worldToCells(min_x, min_y, max_x, max_y, min_i, min_j, max_i, max_j)) {
+    return false;
+  }
+  return queryCells(min_i, min_j, max_i, max_j, min_value, max_value);
+}
+
+bool MaskPyramid::queryCells(
+  unsigned int min_i, unsigned int min_j, unsigned int max_i, unsigned int max_j,
+  int8_t & min_value, int8_t & max_value) const
+{
+  if (!mask_) {
+    return false;
+  }
+  max_i = std::min(max_i, mask_->info.width - 1);
+  max_j = std::min(max_j, mask_->info.height - 1);
+  if (min_i > max_i || min_j > max_j) {
+    return false;
+  }
+
+  min_value = NO_MIN;
+  max_value = NO_MAX;
+  descend(min_i, min_j, max_i, max_j, min_value, max_value, nullptr);
+  return max_value != NO_MAX;
+}
+
+bool MaskPyramid::anyAtLeast(
+  double min_x, double min_y, double max_x, double max_y, int8_t threshold) const
+{
+  unsigned int min_i, min_j, max_i, max_j;
+  if (!worldToCells(min_x, min_y, max_x, max_y, min_i, min_j, max_i, max_j)) {
+    return false;
+  }
+
+  int8_t min_value = NO_MIN;
+  int8_t max_value = NO_MAX;
+  return descend(min_i, min_j, max_i, max_j, min_value, max_value, &threshold);
+}
+
+bool MaskPyramid::descend(
+  unsigned int min_i, unsigned int min_j, unsigned int max_i, unsigned int max_j,
+  int8_t & min_value, int8_t & max_value, const int8_t * stop_threshold) const
+{
+  struct Node
+  {
+    unsigned int level, i, j;
+  };
+
+  // Depth-first: at most 3 pending siblings per level plus the 4 last children
+  std::array<Node, 3 * 32 + 4> stack;
+  size_t top = 0;
+  stack[top++] = Node{levels() - 1, 0, 0};
+
+  while (top > 0) {
+    const Node node = stack[--top];
+
+    // Cells covered by the block, clamped to the mask
+    const unsigned int x0 = node.i << node.level;
+    const unsigned int y0 = node.j << node.level;
+    const unsigned int x1 = std::min(((node.i + 1) << node.level) - 1, mask_->info.width - 1);
+    const unsigned int y1 = std::min(((node.j + 1) << node.level) - 1, mask_->info.height - 1);
+    if (x0 > max_i || y0 > max_j || x1 < min_i || y1 < min_j) {
+      continue;
+    }
+
+    int8_t block_min, block_max;
+    block(node.level, node.i, node.j, block_min, block_max);
+    if (block_max == NO_MAX) {
+      continue;
+    }
+    if (stop_threshold && block_max < *stop_threshold) {
+      continue;
+    }
+
+    const bool inside = x0 >= min_i && y0 >= min_j && x1 <= max_i && y1 <= max_j;
+    if (inside) {
+      min_value = std::min(min_value, block_min);
+      max_value = std::max(max_value, block_max);
+      if (stop_threshold) {
+        return true;
+      }
+      continue;
+    }
+
+    // A partially covered block can not widen the current range
+    if (!stop_threshold && block_min >= min_value && block_max <= max_value) {
+      continue;
+    }
+
+    // Partially covered blocks are never at level 0 (single cells)
+    const unsigned int child_level = node.level - 1;
+    const unsigned int ci = node.i << 1;
+    const unsigned int cj = node.j << 1;
+    stack[top++] = Node{child_level, ci, cj};
+    if (((ci + 1) << child_level) < mask_->info.width) {
+      stack[top++] = Node{child_level, ci + 1, cj};
+    }
+    if (((cj + 1) << child_level) < mask_->info.height) {
+      stack[top++] = Node{child_level, ci, cj + 1};
+      if (((ci + 1) << child_level) < mask_->info.width) {
+        stack[top++] = Node{child_level, ci + 1, cj + 1};
+      }
+    }
+  }
+
+  return false;
+}
+
+}  // namespace nav2_costmap_filters_demo
@@ -0,0 +1,249 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_filters_demo/mask_server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "nav2_costmap_filters_demo/mask_loader.hpp"
+
+namespace nav2_costmap_filters_demo
+{
+
+MaskServer::MaskServer(const rclcpp::NodeOptions & options)
+: nav2_util::LifecycleNode("filter_mask_server", "", options)
+{
+  RCLCPP_INFO(get_logger(), "Creating");
+
+  // Same parameters as nav2_map_server, so the demo params files are reused as is
+  declare_parameter("yaml_filename", rclcpp::ParameterValue(std::string("")));
+  declare_parameter("topic_name", rclcpp::ParameterValue(std::string("map")));
+  declare_parameter("frame_id", rclcpp::ParameterValue(std::string("map")));
+  declare_parameter("build_pyramid", rclcpp::ParameterValue(true));
+
+  // Rolling window serving of tiled (.tmask) masks
+  declare_parameter("rolling_window_size", rclcpp::ParameterValue(50.0));
+  declare_parameter("window_update_period", rclcpp::ParameterValue(1.0));
+  declare_parameter("max_cached_tiles", rclcpp::ParameterValue(64));
+  declare_parameter("robot_base_frame", rclcpp::ParameterValue(std::string("base_link")));
+}
+
+MaskServer::~MaskServer()
+{
+}
+
+nav2_util::CallbackReturn
+MaskServer::on_configure(const rclcpp_lifecycle::State & /*state*/)
+{
+  RCLCPP_INFO(get_logger(), "Configuring");
+
+  const std::string yaml_filename = get_parameter("yaml_filename").as_string();
+  const std::string topic_name = get_parameter("topic_name").as_string();
+
+  frame_id_ = get_parameter("frame_id").as_string();
+  build_pyramid_ = get_parameter("build_pyramid").as_bool();
+
+  const auto load_start = std::chrono::steady_clock::now();
+  try {
+    const MaskParameters params = loadMaskYaml(yaml_filename);
+    const std::string & image = params.image_file_name;
+    const std::string extension = TILED_MASK_EXTENSION;
+    if (image.size() > extension.size() &&
+      image.compare(image.size() - extension.size(), extension.size(), extension) == 0)
+    {
+      tiled_mask_ = std::make_unique<TiledMask>(
+        image, get_parameter("max_cached_tiles").as_int());
+    } else {
+      mask_ = std::make_shared<nav_msgs::msg::OccupancyGrid>();
+      loadMask(params, *mask_);
+    }
+  } catch (std::exception & e) {
+    RCLCPP_ERROR(get_logger(), "Failed to load mask %s: %s", yaml_filename.c_str(), e.what());
+    mask_.reset();
+    tiled_mask_.reset();
+    return nav2_util::CallbackReturn::FAILURE;
+  }
+  const double load_time = std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - load_start).count();
+
+  if (tiled_mask_) {
+    // Only the window around the robot is ever paged in
+    window_size_ = get_parameter("rolling_window_size").as_double();
+    robot_base_frame_ = get_parameter("robot_base_frame").as_string();
+    const auto & header = tiled_mask_->header();
+    const size_t max_tiles = std::max<size_t>(
+      get_parameter("max_cached_tiles").as_int(),
+      tiled_mask_->tilesForWindow(window_size_, window_size_));
+    RCLCPP_INFO(
+      get_logger(), "Opened %ux%u tiled mask %s in %.3f s, serving %.1f m windows "
+      "with at most %zu MB of tiles", header.width, header.height, yaml_filename.c_str(),
+      load_time, window_size_,
+      max_tiles * header.tile_size * header.tile_size / (1024 * 1024));
+
+    tf_buffer_ = std::make_shared<tf2_ros::Buffer>(get_clock());
+    tf_listener_ = std::make_shared<tf2_ros::TransformListener>(*tf_buffer_);
+  } else {
+    RCLCPP_INFO(
+      get_logger(), "Loaded %ux%u mask %s in %.3f s", mask_->info.width, mask_->info.height,
+      yaml_filename.c_str(), load_time);
+
+    mask_->header.frame_id = frame_id_;
+    mask_->info.map_load_time = now();
+
+    if (build_pyramid_) {
+      const auto pyramid_start = std::chrono::steady_clock::now();
+      pyramid_.build(mask_);
+      RCLCPP_INFO(
+        get_logger(), "Built %u level mask pyramid in %.3f s", pyramid_.levels(),
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - pyramid_start).count());
+    }
+  }
+
+  if (build_pyramid_) {
+    query_region_service_ = create_service<srv::QueryMaskRegion>(
+      "~/query_region",
+      std::bind(
+        &MaskServer::queryRegionCallback, this,
+        std::placeholders::_1, std::placeholders::_2));
+  }
+
+  // Masks are latched for late-joining costmap filters
+  mask_pub_ = create_publisher<nav_msgs::msg::OccupancyGrid>(
+    topic_name, rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable());
+
+  return nav2_util::CallbackReturn::SUCCESS;
+}
+
+nav2_util::CallbackReturn
+MaskServer::on_activate(const rclcpp_lifecycle::State & /*state*/)
+{
+  RCLCPP_INFO(get_logger(), "Activating");
+
+  mask_pub_->on_activate();
+  if (tiled_mask_) {
+    updateWindow();
+    window_timer_ = create_wall_timer(
+      std::chrono::duration<double>(get_parameter("window_update_period").as_double()),
+      std::bind(&MaskServer::updateWindow, this));
+  } else {
+    mask_->header.stamp = now();
+    // Published by reference: the grid is serialized straight from mask_
+    mask_pub_->publish(*mask_);
+  }
+
+  createBond();
+
+  return nav2_util::CallbackReturn::SUCCESS;
+}
+
+nav2_util::CallbackReturn
+MaskServer::on_deactivate(const rclcpp_lifecycle::State & /*state*/)
+{
+  RCLCPP_INFO(get_logger(), "Deactivating");
+
+  window_timer_.reset();
+  mask_pub_->on_deactivate();
+
+  destroyBond();
+
+  return nav2_util::CallbackReturn::SUCCESS;
+}
+
+nav2_util::CallbackReturn
+MaskServer::on_cleanup(const rclcpp_lifecycle::State & /*state*/)
+{
+  RCLCPP_INFO(get_logger(), "Cleaning up");
+
+  query_region_service_.reset();
+  pyramid_.clear();
+  mask_pub_.reset();
+  mask_.reset();
+  tf_listener_.reset();
+  tf_buffer_.reset();
+  tiled_mask_.reset();
+
+  return nav2_util::CallbackReturn::SUCCESS;
+}
+
+nav2_util::CallbackReturn
+MaskServer::on_shutdown(const rclcpp_lifecycle::State & /*state*/)
+{
+  RCLCPP_INFO(get_logger(), "Shutting down");
+  return nav2_util::CallbackReturn::SUCCESS;
+}
+
+void MaskServer::updateWindow()
+{
+  geometry_msgs::msg::TransformStamped robot_pose;
+  try {
+    robot_pose = tf_buffer_->lookupTransform(frame_id_, robot_base_frame_, tf2::TimePointZero);
+  } catch (tf2::TransformException & ex) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000, "Robot pose is not available for the mask window: %s",
+      ex.what());
+    return;
+  }
+
+  // Recenter only when the robot leaves the central half of the current window
+  const double x = robot_pose.transform.translation.x;
+  const double y = robot_pose.transform.translation.y;
+  if (mask_ && std::abs(x - window_x_) < window_size_ / 4.0 &&
+    std::abs(y - window_y_) < window_size_ / 4.0)
+  {
+    return;
+  }
+
+  auto window = std::make_shared<nav_msgs::msg::OccupancyGrid>();
+  try {
+    tiled_mask_->getWindow(x, y, window_size_, window_size_, *window);
+  } catch (std::exception & e) {
+    RCLCPP_ERROR(get_logger(), "Failed to read mask tiles: %s", e.what());
+    return;
+  }
+  window->header.frame_id = frame_id_;
+  window->header.stamp = now();
+  window->info.map_load_time = window->header.stamp;
+
+  window_x_ = x;
+  window_y_ = y;
+  mask_ = window;
+  if (build_pyramid_) {
+    pyramid_.build(mask_);
+  }
+  mask_pub_->publish(*mask_);
+}
+
+void MaskServer::queryRegionCallback(
+  const std::shared_ptr<srv::QueryMaskRegion::Request> request,
+  std::shared_ptr<srv::QueryMaskRegion::Response> response)
+{
+  response->success = pyramid_.queryRegion(
+    request->min_x, request->min_y, request->max_x, request->max_y,
+    response->min_value, response->max_value);
+}
+
+}  // namespace nav2_costmap_filters_demo
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+// Register the component with class_loader.
+// This acts as a sort of entry point, allowing the component to be discoverable when its library
+// is being loaded into a running process.
+RCLCPP_COMPONENTS_REGISTER_NODE(nav2_costmap_filters_demo::MaskServer)
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Converts a PGM filter mask into a tiled mask served in rolling windows:
+//   mask_tiler <mask.yaml> <output_prefix> [tile_size]
+// writes <output_prefix>.tmask and a <output_prefix>.yaml to pass as the mask
+// argument of costmap_filter_info.launch.py (with use_native_mask_server:=True).
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "nav2_costmap_filters_demo/mask_loader.hpp"
+#include "nav2_costmap_filters_demo/tiled_mask.hpp"
+
+int main(int argc, char ** argv)
+{
+  if (argc < 3 || argc > 4) {
+    std::fprintf(stderr, "Usage: %s <mask.yaml> <output_prefix> [tile_size]\n", argv[0]);
+    return 1;
+  }
+
+  const std::string output_prefix = argv[2];
+  const unsigned int tile_size = argc == 4 ? std::strtoul(argv[3], nullptr, 10) : 256;
+
+  try {
+    const auto params = nav2_costmap_filters_demo::loadMaskYaml(argv[1]);
+    const std::string tiles_filename =
+      output_prefix + nav2_costmap_filters_demo::TILED_MASK_EXTENSION;
+    nav2_costmap_filters_demo::writeTiledMask(params, tile_size, tiles_filename);
+
+    // Tiles already hold OccupancyGrid values, the thresholds are kept for reference
+    const size_t slash = tiles_filename.find_last_of('/');
+    std::ofstream yaml(output_prefix + ".yaml");
+    yaml << "image: " <<
+      (slash == std::string::npos ? tiles_filename : tiles_filename.substr(slash + 1)) << "\n";
+    yaml << "mode: " <<
+      (params.mode == nav2_costmap_filters_demo::MaskMode::Trinary ? "trinary" :
+      params.mode == nav2_costmap_filters_demo::MaskMode::Scale ? "scale" : "raw") << "\n";
+    yaml << "resolution: " << params.resolution << "\n";
+    yaml << "origin: [" << params.origin[0] << ", " << params.origin[1] << ", " <<
+      params.origin[2] << "]\n";
+    yaml << "negate: " << (params.negate ? 1 : 0) << "\n";
+    yaml << "occupied_thresh: " << params.occupied_thresh << "\n";
+    yaml << "free_thresh: " << params.free_thresh << "\n";
+    if (!yaml) {
+      throw std::runtime_error("Failed to write " + output_prefix + ".yaml");
+    }
+  } catch (std::exception & e) {
+    std::fprintf(stderr, "Failed to tile mask: %s\n", e.what());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,247 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "nav2_costmap_filters_demo/tiled_mask.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nav2_costmap_filters_demo
+{
+
+namespace
+{
+
+constexpr char TILED_MASK_MAGIC[8] = {'N', '2', 'T', 'M', 'A', 'S', 'K', '\0'};
+constexpr uint32_t TILED_MASK_VERSION = 1;
+
+// Reads exactly size bytes at offset, retrying on short reads
+void preadAll(int fd, void * buffer, size_t size, uint64_t offset)
+{
+  uint8_t * dst = static_cast<uint8_t *>(buffer);
+  while (size > 0) {
+    const ssize_t n = pread(fd, dst, size, static_cast<off_t>(offset));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      throw std::runtime_error("Failed to read tiled mask: unexpected end of file");
+    }
+    dst += n;
+    size -= static_cast<size_t>(n);
+    offset += static_cast<uint64_t>(n);
+  }
+}
+
+}  // namespace
+
+void writeTiledMask(
+  const MaskParameters & params, unsigned int tile_size, const std::string & filename)
+{
+  if (tile_size == 0) {
+    throw std::runtime_error("Tile size should be positive");
+  }
+
+  PgmImage image(params.image_file_name);
+  const MaskLut lut = buildMaskLut(params, image.maxValue());
+  const size_t width = image.width();
+  const size_t height = image.height();
+  const size_t tile_cells = static_cast<size_t>(tile_size) * tile_size;
+
+  TiledMaskHeader header;
+  std::memcpy(header.magic, TILED_MASK_MAGIC, sizeof(header.magic));
+  header.version = TILED_MASK_VERSION;
+  header.tile_size = tile_size;
+  header.width = image.width();
+  header.height = image.height();
+  header.tiles_x = (image.width() + tile_size - 1) / tile_size;
+  header.tiles_y = (image.height() + tile_size - 1) / tile_size;
+  header.resolution = params.resolution;
+  header.origin_x = params.origin[0];
+  header.origin_y = params.origin[1];
+  header.data_offset = sizeof(TiledMaskHeader);
+
+  FILE * file = std::fopen(filename.c_str(), "wb");
+  if (!file) {
+    throw std::runtime_error("Failed to open " + filename + ": " + std::strerror(errno));
+  }
+
+  // One row of tiles is converted at a time
+  std::vector<int8_t> tile_row(header.tiles_x * tile_cells);
+  bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+  for (uint32_t ty = 0; ok && ty < header.tiles_y; ++ty) {
+    std::fill(tile_row.begin(), tile_row.end(), -1);
+    const size_t row_end = std::min(height, static_cast<size_t>(ty + 1) * tile_size);
+    for (size_t r = static_cast<size_t>(ty) * tile_size; r < row_end; ++r) {
+      // Image rows go top to bottom while the grid rows go bottom to top
+      const uint8_t * src = image.pixels() + (height - r - 1) * width;
+      const size_t tile_row_offset = (r % tile_size) * tile_size;
+      for (size_t x = 0; x < width; ++x) {
+        tile_row[(x / tile_size) * tile_cells + tile_row_offset + x % tile_size] = lut[src[x]];
+      }
+    }
+    ok = std::fwrite(tile_row.data(), 1, tile_row.size(), file) == tile_row.size();
+  }
+
+  if (std::fclose(file) != 0 || !ok) {
+    throw std::runtime_error("Failed to write " + filename);
+  }
+}
+
+TiledMask::TiledMask(const std::string & filename, size_t max_tiles)
+: max_tiles_(std::max<size_t>(max_tiles, 1))
+{
+  fd_ = open(filename.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    throw std::runtime_error("Failed to open " + filename + ": " + std::strerror(errno));
+  }
+
+  try {
+    preadAll(fd_, &header_, sizeof(header_), 0);
+    if (std::memcmp(header_.magic, TILED_MASK_MAGIC, sizeof(header_.magic)) != 0 ||
+      header_.version != TILED_MASK_VERSION)
+    {
+      throw std::runtime_error(filename + " is not a tiled mask file");
+    }
+    if (header_.tile_size == 0 || header_.resolution <= 0.0 ||
+      header_.tiles_x != (header_.width + header_.tile_size - 1) / header_.tile_size ||
+      header_.tiles_y != (header_.height + header_.tile_size - 1) / header_.tile_size)
+    {
+      throw std::runtime_error(filename + " has an inconsistent header");
+    }
+
+    struct stat st;
+    const uint64_t expected_size = header_.data_offset +
+      static_cast<uint64_t>(header_.tiles_x) * header_.tiles_y *
+      header_.tile_size * header_.tile_size;
+    if (fstat(fd_, &st) != 0 || static_cast<uint64_t>(st.st_size) < expected_size) {
+      throw std::runtime_error(filename + " is truncated");
+    }
+  } catch (...) {
+    close(fd_);
+    throw;
+  }
+}
+
+TiledMask::~TiledMask()
+{
+  close(fd_);
+}
+
+size_t TiledMask::tilesForWindow(double size_x, double size_y) const
+{
+  const double tile_meters = header_.tile_size * header_.resolution;
+  // A window not aligned to the tiles overlaps one more tile per axis
+  return static_cast<size_t>(
+    (std::ceil(size_x / tile_meters) + 1) * (std::ceil(size_y / tile_meters) + 1));
+}
+
+const int8_t * TiledMask::tile(uint32_t tx, uint32_t ty)
+{
+  const uint64_t key = (static_cast<uint64_t>(ty) << 32) | tx;
+  auto it = cache_.find(key);
+  if (it != cache_.end()) {
+    // Move to the front of the LRU list
+    lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+    return it->second.data.data();
+  }
+
+  // Evict the least recently used tile and recycle its buffer
+  std::vector<int8_t> data;
+  if (cache_.size() >= max_tiles_) {
+    auto evicted = cache_.find(lru_.back());
+    data = std::move(evicted->second.data);
+    cache_.erase(evicted);
+    lru_.pop_back();
+  }
+
+  const size_t tile_cells = static_cast<size_t>(header_.tile_size) * header_.tile_size;
+  data.resize(tile_cells);
+  preadAll(
+    fd_, data.data(), tile_cells,
+    header_.data_offset + (static_cast<uint64_t>(ty) * header_.tiles_x + tx) * tile_cells);
+
+  lru_.push_front(key);
+  CachedTile & cached = cache_[key];
+  cached.lru_position = lru_.begin();
+  cached.data = std::move(data);
+  return cached.data.data();
+}
+
+void TiledMask::getWindow(
+  double x, double y, double size_x, double size_y, nav_msgs::msg::OccupancyGrid & msg)
+{
+  max_tiles_ = std::max(max_tiles_, tilesForWindow(size_x, size_y));
+
+  const double resolution = header_.resolution;
+  const int64_t cells_x = std::max<int64_t>(1, std::llround(size_x / resolution));
+  const int64_t cells_y = std::max<int64_t>(1, std::llround(size_y / resolution));
+  const int64_t i0 = static_cast<int64_t>(std::floor((x - header_.origin_x) / resolution)) -
+    cells_x / 2;
+  const int64_t j0 = static_cast<int64_t>(std::floor((y - header_.origin_y) / resolution)) -
+    cells_y / 2;
+
+  msg.info.resolution = resolution;
+  msg.info.width = static_cast<uint32_t>(cells_x);
+  msg.info.height = static_cast<uint32_t>(cells_y);
+  msg.info.origin.position.x = header_.origin_x + i0 * resolution;
+  msg.info.origin.position.y = header_.origin_y + j0 * resolution;
+  msg.info.origin.position.z = 0.0;
+  msg.info.origin.orientation.x = 0.0;
+  msg.info.origin.orientation.y = 0.0;
+  msg.info.origin.orientation.z = 0.0;
+  msg.info.origin.orientation.w = 1.0;
+  msg.data.assign(static_cast<size_t>(cells_x * cells_y), -1);
+
+  // Part of the window covered by the mask
+  const int64_t c0 = std::max<int64_t>(i0, 0);
+  const int64_t c1 = std::min<int64_t>(i0 + cells_x, header_.width);
+  const int64_t r0 = std::max<int64_t>(j0, 0);
+  const int64_t r1 = std::min<int64_t>(j0 + cells_y, header_.height);
+  if (c0 >= c1 || r0 >= r1) {
+    return;
+  }
+
+  const int64_t tile_size = header_.tile_size;
+  for (int64_t ty = r0 / tile_size; ty <= (r1 - 1) / tile_size; ++ty) {
+    for (int64_t tx = c0 / tile_size; tx <= (c1 - 1) / tile_size; ++tx) {
+      const int8_t * data = tile(static_cast<uint32_t>(tx), static_cast<uint32_t>(ty));
+
+      // Copy the overlapping part of the tile row by row
+      const int64_t tc0 = std::max(c0, tx * tile_size);
+      const int64_t tc1 = std::min(c1, (tx + 1) * tile_size);
+      const int64_t tr0 = std::max(r0, ty * tile_size);
+      const int64_t tr1 = std::min(r1, (ty + 1) * tile_size);
+      for (int64_t r = tr0; r < tr1; ++r) {
+        std::memcpy(
+          &msg.data[static_cast<size_t>((r - j0) * cells_x + (tc0 - i0))],
+          data + (r - ty * tile_size) * tile_size + (tc0 - tx * tile_size),
+          static_cast<size_t>(tc1 - tc0));
+      }
+    }
+  }
+}
+
+}  // namespace nav2_costmap_filters_demo
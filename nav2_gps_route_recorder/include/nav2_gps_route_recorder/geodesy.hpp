@@ -0,0 +1,378 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef NAV2_GPS_ROUTE_RECORDER__GEODESY_HPP_
+#define NAV2_GPS_ROUTE_RECORDER__GEODESY_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+// Header-only geodesic conversions for batches of GPS points: WGS84
+// latitude/longitude to UTM and to a local ENU frame, and back, plus the
+// quaternion/yaw helpers of gps_utils.py. The per-zone and per-origin
+// constants are computed once by the projection objects, so converting a
+// route is a tight loop over plain arrays. Angles are in degrees for
+// latitudes/longitudes and in radians otherwise.
+
+namespace nav2_gps_route_recorder
+{
+
+namespace geodesy
+{
+
+// WGS84 ellipsoid
+constexpr double WGS84_A = 6378137.0;
+constexpr double WGS84_F = 1.0 / 298.257223563;
+constexpr double WGS84_E2 = WGS84_F * (2.0 - WGS84_F);
+
+constexpr double UTM_K0 = 0.9996;
+constexpr double UTM_FALSE_EASTING = 500000.0;
+constexpr double UTM_FALSE_NORTHING_SOUTH = 10000000.0;
+
+constexpr double DEG_TO_RAD = M_PI / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / M_PI;
+
+struct Quaternion
+{
+  double x;
+  double y;
+  double z;
+  double w;
+};
+
+// Same convention as quaternion_from_euler() of gps_utils.py
+inline Quaternion quaternionFromEuler(double roll, double pitch, double yaw)
+{
+  const double cy = std::cos(yaw * 0.5);
+  const double sy = std::sin(yaw * 0.5);
+  const double cp = std::cos(pitch * 0.5);
+  const double sp = std::sin(pitch * 0.5);
+  const double cr = std::cos(roll * 0.5);
+  const double sr = std::sin(roll * 0.5);
+
+  Quaternion q;
+  q.w = cy * cp * cr + sy * sp * sr;
+  q.x = cy * cp * sr - sy * sp * cr;
+  q.y = sy * cp * sr + cy * sp * cr;
+  q.z = sy * cp * cr - cy * sp * sr;
+  return q;
+}
+
+inline void eulerFromQuaternion(
+  const Quaternion & q, double & roll, double & pitch, double & yaw)
+{
+  roll = std::atan2(2.0 * (q.w * q.x + q.y * q.z), 1.0 - 2.0 * (q.x * q.x + q.y * q.y));
+  const double t = 2.0 * (q.w * q.y - q.z * q.x);
+  pitch = std::asin(t > 1.0 ? 1.0 : (t < -1.0 ? -1.0 : t));
+  yaw = std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z));
+}
+
+// Planar orientations only need z and w
+inline void yawToQuaternion(const double * yaw, size_t count, double * qz, double * qw)
+{
+  for (size_t i = 0; i < count; ++i) {
+    qz[i] = std::sin(yaw[i] * 0.5);
+    qw[i] = std::cos(yaw[i] * 0.5);
+  }
+}
+
+inline void quaternionToYaw(
+  const double * qx, const double * qy, const double * qz, const double * qw,
+  size_t count, double * yaw)
+{
+  for (size_t i = 0; i < count; ++i) {
+    yaw[i] = std::atan2(
+      2.0 * (qw[i] * qz[i] + qx[i] * qy[i]),
+      1.0 - 2.0 * (qy[i] * qy[i] + qz[i] * qz[i]));
+  }
+}
+
+// UTM zone of a point, with the Norway and Svalbard exceptions
+inline int utmZone(double latitude, double longitude)
+{
+  // Longitudes in [-180, 180)
+  const double lon = longitude - 360.0 * std::floor((longitude + 180.0) / 360.0);
+  int zone = static_cast<int>(std::floor((lon + 180.0) / 6.0)) + 1;
+  if (zone > 60) {
+    zone = 60;
+  }
+
+  if (latitude >= 56.0 && latitude < 64.0 && lon >= 3.0 && lon < 12.0) {
+    return 32;
+  }
+  if (latitude >= 72.0 && latitude < 84.0 && lon >= 0.0 && lon < 42.0) {
+    if (lon < 9.0) {
+      return 31;
+    } else if (lon < 21.0) {
+      return 33;
+    } else if (lon < 33.0) {
+      return 35;
+    }
+    return 37;
+  }
+  return zone;
+}
+
+// Transverse Mercator projection of one UTM zone, using the 4th order
+// Krueger series (sub-millimeter inside the zone)
+class UTMProjection
+{
+public:
+  UTMProjection(int zone, bool north)
+  : zone_(zone), north_(north),
+    central_meridian_((zone * 6.0 - 183.0) * DEG_TO_RAD),
+    false_northing_(north ? 0.0 : UTM_FALSE_NORTHING_SOUTH)
+  {
+    const double n = WGS84_F / (2.0 - WGS84_F);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    const double n4 = n3 * n;
+
+    scale_ = UTM_K0 * WGS84_A / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0);
+    conformal_ = 2.0 * std::sqrt(n) / (1.0 + n);
+
+    alpha_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0;
+    alpha_[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0;
+    alpha_[2] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0;
+    alpha_[3] = 49561.0 * n4 / 161280.0;
+
+    beta_[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0;
+    beta_[1] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0;
+    beta_[2] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0;
+    beta_[3] = 4397.0 * n4 / 161280.0;
+
+    delta_[0] = 2.0 * n - 2.0 * n2 / 3.0 - 2.0 * n3 + 116.0 * n4 / 45.0;
+    delta_[1] = 7.0 * n2 / 3.0 - 8.0 * n3 / 5.0 - 227.0 * n4 / 45.0;
+    delta_[2] = 56.0 * n3 / 15.0 - 136.0 * n4 / 35.0;
+    delta_[3] = 4279.0 * n4 / 630.0;
+  }
+
+  // Projection of the zone containing (latitude, longitude)
+  static UTMProjection forPoint(double latitude, double longitude)
+  {
+    return UTMProjection(utmZone(latitude, longitude), latitude >= 0.0);
+  }
+
+  int zone() const {return zone_;}
+  bool north() const {return north_;}
+
+  void forward(double latitude, double longitude, double & easting, double & northing) const
+  {
+    const double lat = latitude * DEG_TO_RAD;
+    const double dlon = longitude * DEG_TO_RAD - central_meridian_;
+    const double sin_lat = std::sin(lat);
+    const double t = std::sinh(
+      std::atanh(sin_lat) - conformal_ * std::atanh(conformal_ * sin_lat));
+    const double xi = std::atan2(t, std::cos(dlon));
+    const double eta = std::atanh(std::sin(dlon) / std::sqrt(1.0 + t * t));
+
+    double x, y;
+    series(alpha_, xi, eta, x, y);
+    x = eta + x;
+    y = xi + y;
+    easting = UTM_FALSE_EASTING + scale_ * x;
+    northing = false_northing_ + scale_ * y;
+  }
+
+  void inverse(double easting, double northing, double & latitude, double & longitude) const
+  {
+    const double xi = (northing - false_northing_) / scale_;
+    const double eta = (easting - UTM_FALSE_EASTING) / scale_;
+
+    double d_eta, d_xi;
+    series(beta_, xi, eta, d_eta, d_xi);
+    const double xi_p = xi - d_xi;
+    const double eta_p = eta - d_eta;
+
+    const double chi = std::asin(std::sin(xi_p) / std::cosh(eta_p));
+    // sin(2j chi) by the angle addition recurrence
+    const double s2 = std::sin(2.0 * chi);
+    const double c2 = std::cos(2.0 * chi);
+    double s = s2;
+    double c = c2;
+    double lat = chi;
+    for (int j = 0; j < 4; ++j) {
+      lat += delta_[j] * s;
+      const double next_s = s * c2 + c * s2;
+      c = c * c2 - s * s2;
+      s = next_s;
+    }
+    latitude = lat * RAD_TO_DEG;
+    longitude = (central_meridian_ + std::atan2(std::sinh(eta_p), std::cos(xi_p))) * RAD_TO_DEG;
+  }
+
+  void forward(
+    const double * latitude, const double * longitude, size_t count,
+    double * easting, double * northing) const
+  {
+    for (size_t i = 0; i < count; ++i) {
+      forward(latitude[i], longitude[i], easting[i], northing[i]);
+    }
+  }
+
+  void inverse(
+    const double * easting, const double * northing, size_t count,
+    double * latitude, double * longitude) const
+  {
+    for (size_t i = 0; i < count; ++i) {
+      inverse(easting[i], northing[i], latitude[i], longitude[i]);
+    }
+  }
+
+private:
+  // Sums of c[j] cos(2j xi) sinh(2j eta) and c[j] sin(2j xi) cosh(2j eta),
+  // the multiple angles being built by addition recurrences instead of
+  // evaluating 16 transcendental functions per point
+  static void series(const double (&c)[4], double xi, double eta, double & x, double & y)
+  {
+    const double s2 = std::sin(2.0 * xi);
+    const double c2 = std::cos(2.0 * xi);
+    const double e2 = std::exp(2.0 * eta);
+    const double sh2 = 0.5 * (e2 - 1.0 / e2);
+    const double ch2 = 0.5 * (e2 + 1.0 / e2);
+
+    double s = s2, co = c2, sh = sh2, ch = ch2;
+    x = 0.0;
+    y = 0.0;
+    for (int j = 0; j < 4; ++j) {
+      x += c[j] * co * sh;
+      y += c[j] * s * ch;
+      const double next_s = s * c2 + co * s2;
+      co = co * c2 - s * s2;
+      s = next_s;
+      const double next_sh = sh * ch2 + ch * sh2;
+      ch = ch * ch2 + sh * sh2;
+      sh = next_sh;
+    }
+  }
+
+  int zone_;
+  bool north_;
+  double central_meridian_;
+  double false_northing_;
+  double scale_;
+  double conformal_;
+  double alpha_[4];
+  double beta_[4];
+  double delta_[4];
+};
+
+// East-North-Up frame tangent to the ellipsoid at an origin point
+class LocalCartesian
+{
+public:
+  LocalCartesian(double latitude, double longitude, double altitude = 0.0)
+  {
+    const double lat = latitude * DEG_TO_RAD;
+    const double lon = longitude * DEG_TO_RAD;
+    sin_lat_ = std::sin(lat);
+    cos_lat_ = std::cos(lat);
+    sin_lon_ = std::sin(lon);
+    cos_lon_ = std::cos(lon);
+    toECEF(latitude, longitude, altitude, x0_, y0_, z0_);
+  }
+
+  void forward(
+    double latitude, double longitude, double altitude,
+    double & east, double & north, double & up) const
+  {
+    double x, y, z;
+    toECEF(latitude, longitude, altitude, x, y, z);
+    x -= x0_;
+    y -= y0_;
+    z -= z0_;
+    const double t = cos_lon_ * x + sin_lon_ * y;
+    east = -sin_lon_ * x + cos_lon_ * y;
+    north = -sin_lat_ * t + cos_lat_ * z;
+    up = cos_lat_ * t + sin_lat_ * z;
+  }
+
+  void inverse(
+    double east, double north, double up,
+    double & latitude, double & longitude, double & altitude) const
+  {
+    const double t = -sin_lat_ * north + cos_lat_ * up;
+    const double x = x0_ - sin_lon_ * east + cos_lon_ * t;
+    const double y = y0_ + cos_lon_ * east + sin_lon_ * t;
+    const double z = z0_ + cos_lat_ * north + sin_lat_ * up;
+    fromECEF(x, y, z, latitude, longitude, altitude);
+  }
+
+  void forward(
+    const double * latitude, const double * longitude, const double * altitude, size_t count,
+    double * east, double * north, double * up) const
+  {
+    for (size_t i = 0; i < count; ++i) {
+      forward(latitude[i], longitude[i], altitude ? altitude[i] : 0.0, east[i], north[i], up[i]);
+    }
+  }
+
+  void inverse(
+    const double * east, const double * north, const double * up, size_t count,
+    double * latitude, double * longitude, double * altitude) const
+  {
+    for (size_t i = 0; i < count; ++i) {
+      inverse(east[i], north[i], up ? up[i] : 0.0, latitude[i], longitude[i], altitude[i]);
+    }
+  }
+
+  static void toECEF(
+    double latitude, double longitude, double altitude, double & x, double & y, double & z)
+  {
+    const double lat = latitude * DEG_TO_RAD;
+    const double lon = longitude * DEG_TO_RAD;
+    const double sin_lat = std::sin(lat);
+    const double cos_lat = std::cos(lat);
+    const double n = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+    x = (n + altitude) * cos_lat * std::cos(lon);
+    y = (n + altitude) * cos_lat * std::sin(lon);
+    z = (n * (1.0 - WGS84_E2) + altitude) * sin_lat;
+  }
+
+  // Fixed point iteration on the latitude, converged to well below a
+  // millimeter after a few steps for points near the ellipsoid surface
+  static void fromECEF(
+    double x, double y, double z, double & latitude, double & longitude, double & altitude)
+  {
+    const double p = std::hypot(x, y);
+    double lat = std::atan2(z, p * (1.0 - WGS84_E2));
+    double h = 0.0;
+    for (int i = 0; i < 4; ++i) {
+      const double sin_lat = std::sin(lat);
+      const double n = WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+      h = p / std::cos(lat) - n;
+      lat = std::atan2(z, p * (1.0 - WGS84_E2 * n / (n + h)));
+    }
+    latitude = lat * RAD_TO_DEG;
+    longitude = std::atan2(y, x) * RAD_TO_DEG;
+    altitude = h;
+  }
+
+private:
+  double sin_lat_, cos_lat_, sin_lon_, cos_lon_;
+  // Origin in ECEF
+  double x0_, y0_, z0_;
+};
+
+}  // namespace geodesy
+
+}  // namespace nav2_gps_route_recorder
+
+#endif  // NAV2_GPS_ROUTE_RECORDER__GEODESY_HPP_
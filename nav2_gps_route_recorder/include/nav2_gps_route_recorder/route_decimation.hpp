@@ -0,0 +1,211 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef NAV2_GPS_ROUTE_RECORDER__ROUTE_DECIMATION_HPP_
+#define NAV2_GPS_ROUTE_RECORDER__ROUTE_DECIMATION_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Route decimation in a local metric frame (ENU or UTM): points are dropped as
+// long as the polyline through the kept ones stays within a maximum
+// cross-track error of every dropped point, and no kept point is farther than
+// a maximum yaw change from the previous one, so the heading at turns survives.
+// Same algorithm as decimate_route() of utils/route_decimation.py.
+
+namespace nav2_gps_route_recorder
+{
+
+// Squared distance from (px, py) to the segment (ax, ay) - (bx, by)
+inline double segmentDistanceSq(
+  double px, double py, double ax, double ay, double bx, double by)
+{
+  const double dx = bx - ax;
+  const double dy = by - ay;
+  const double length_sq = dx * dx + dy * dy;
+  double t = 0.0;
+  if (length_sq > 0.0) {
+    t = ((px - ax) * dx + (py - ay) * dy) / length_sq;
+    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+  }
+  const double ex = ax + t * dx - px;
+  const double ey = ay + t * dy - py;
+  return ex * ex + ey * ey;
+}
+
+// Offline Douglas-Peucker decimation of a whole route. Sets keep[i] for the
+// kept points (the first and last ones always are) and returns their number.
+// yaw may be null to ignore headings. The recursion is replaced by an
+// explicit stack. The cost is O(n log n) when splits fall near the middle of
+// their range, and O(n^2) in the worst case, when every split only peels one
+// point off an end (e.g. a spiral). Heading changes bound it to O(m^2) for m
+// the longest run of points between two turns. Hershberger-Snoeyink's
+// O(n log n) bound does not apply: it measures distances to the supporting
+// line, this measures them to the segment.
+inline size_t decimateRoute(
+  const double * x, const double * y, const double * yaw, size_t count,
+  double max_cross_track_error, double max_yaw_change, std::vector<char> & keep)
+{
+  keep.assign(count, 0);
+  if (count == 0) {
+    return 0;
+  }
+  keep[0] = 1;
+  keep[count - 1] = 1;
+
+  // Turns split the route first: both ends of a heading change are kept
+  if (yaw) {
+    size_t anchor = 0;
+    for (size_t i = 1; i < count; ++i) {
+      if (std::abs(std::remainder(yaw[i] - yaw[anchor], 2.0 * M_PI)) > max_yaw_change) {
+        keep[i - 1] = 1;
+        keep[i] = 1;
+        anchor = i;
+      }
+    }
+  }
+
+  const double max_error_sq = max_cross_track_error * max_cross_track_error;
+  std::vector<std::pair<size_t, size_t>> stack;
+  size_t first = 0;
+  for (size_t last = 1; last < count; ++last) {
+    if (!keep[last]) {
+      continue;
+    }
+    stack.emplace_back(first, last);
+    first = last;
+
+    while (!stack.empty()) {
+      const auto range = stack.back();
+      stack.pop_back();
+
+      double worst_sq = max_error_sq;
+      size_t worst = range.first;
+      for (size_t i = range.first + 1; i < range.second; ++i) {
+        const double d = segmentDistanceSq(
+          x[i], y[i], x[range.first], y[range.first], x[range.second], y[range.second]);
+        if (d > worst_sq) {
+          worst_sq = d;
+          worst = i;
+        }
+      }
+      if (worst != range.first) {
+        keep[worst] = 1;
+        stack.emplace_back(range.first, worst);
+        stack.emplace_back(worst, range.second);
+      }
+    }
+  }
+
+  size_t kept = 0;
+  for (const char k : keep) {
+    kept += k;
+  }
+  return kept;
+}
+
+// Point of a route being decimated online. The geographic coordinates are
+// only carried along for the caller.
+struct RoutePoint
+{
+  double x;
+  double y;
+  double yaw;
+  double latitude;
+  double longitude;
+};
+
+// Online (opening window) decimation of a route received point by point:
+// a point is emitted once the segment from the previous emitted point to the
+// newest one no longer fits the points in between. The window is bounded and
+// allocated once, so add() does not allocate and costs O(max_window).
+class OnlineRouteDecimator
+{
+public:
+  OnlineRouteDecimator(
+    double max_cross_track_error, double max_yaw_change, size_t max_window = 256)
+  : max_error_sq_(max_cross_track_error * max_cross_track_error),
+    max_yaw_change_(max_yaw_change), max_window_(max_window), has_anchor_(false)
+  {
+    window_.reserve(max_window);
+  }
+
+  // Adds the next route point. Returns true with the point to keep in emitted
+  // when the point is the first one or ends a segment.
+  bool add(const RoutePoint & point, RoutePoint & emitted)
+  {
+    if (!has_anchor_) {
+      anchor_ = point;
+      has_anchor_ = true;
+      emitted = point;
+      return true;
+    }
+
+    bool fits = window_.size() < max_window_;
+    for (size_t i = 0; fits && i < window_.size(); ++i) {
+      const RoutePoint & p = window_[i];
+      fits = segmentDistanceSq(p.x, p.y, anchor_.x, anchor_.y, point.x, point.y) <=
+        max_error_sq_ &&
+        std::abs(std::remainder(p.yaw - anchor_.yaw, 2.0 * M_PI)) <= max_yaw_change_;
+    }
+    if (fits) {
+      window_.push_back(point);
+      return false;
+    }
+
+    // The last point that still fitted becomes the new anchor
+    if (window_.empty()) {
+      anchor_ = point;
+    } else {
+      anchor_ = window_.back();
+      window_.clear();
+      window_.push_back(point);
+    }
+    emitted = anchor_;
+    return true;
+  }
+
+  // Last point of the route, if not emitted yet
+  bool finish(RoutePoint & emitted)
+  {
+    if (window_.empty()) {
+      return false;
+    }
+    emitted = window_.back();
+    anchor_ = emitted;
+    window_.clear();
+    return true;
+  }
+
+private:
+  double max_error_sq_;
+  double max_yaw_change_;
+  size_t max_window_;
+  bool has_anchor_;
+  RoutePoint anchor_;
+  // Points after the anchor not emitted yet
+  std::vector<RoutePoint> window_;
+};
+
+}  // namespace nav2_gps_route_recorder
+
+#endif  // NAV2_GPS_ROUTE_RECORDER__ROUTE_DECIMATION_HPP_
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef NAV2_GPS_ROUTE_RECORDER__ROUTE_RECORDER_HPP_
+#define NAV2_GPS_ROUTE_RECORDER__ROUTE_RECORDER_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+#include "sensor_msgs/msg/imu.hpp"
+#include "sensor_msgs/msg/nav_sat_fix.hpp"
+#include "nav2_gps_route_recorder/geodesy.hpp"
+#include "nav2_gps_route_recorder/route_decimation.hpp"
+#include "nav2_gps_route_recorder/spsc_ring_buffer.hpp"
+
+namespace nav2_gps_route_recorder
+{
+
+// Headless GPS route recorder. Records the fused fix together with the IMU
+// heading every time the robot moved min_distance or turned
+// min_heading_change since the last recorded waypoint, so driving a site once
+// yields a dense but decimated route. With max_cross_track_error set, the
+// waypoints are further decimated online, keeping only the ones needed for
+// the route to stay within that error.
+// Waypoints are appended to a waypoint log (see utils/waypoint_log.py of
+// nav2_gps_waypoint_follower_demo), which the waypoint followers read as is
+// or compact_waypoint_log converts. Message callbacks only do arithmetic and push into a
+// preallocated ring buffer; a background thread writes and syncs the file.
+class RouteRecorder : public rclcpp::Node
+{
+public:
+  explicit RouteRecorder(const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+  ~RouteRecorder();
+
+protected:
+  struct Waypoint
+  {
+    double latitude;
+    double longitude;
+    double yaw;
+  };
+
+  void fixCallback(const sensor_msgs::msg::NavSatFix::ConstSharedPtr msg);
+  void imuCallback(const sensor_msgs::msg::Imu::ConstSharedPtr msg);
+
+  // Queues a waypoint for the writer thread
+  void record(const Waypoint & waypoint);
+
+  // Writer thread: drains the ring buffer every flush_period or when it is half full
+  void writerLoop();
+  // Writes and syncs all queued waypoints, returns false on I/O error
+  bool flush();
+
+  rclcpp::Subscription<sensor_msgs::msg::NavSatFix>::SharedPtr fix_sub_;
+  rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr imu_sub_;
+
+  // Parameters
+  double min_distance_;
+  double min_heading_change_;
+  std::chrono::duration<double> flush_period_;
+
+  // Heading from the last IMU message, NaN until one is received
+  double heading_;
+
+  // Last recorded waypoint, in the UTM zone of the first fix
+  std::unique_ptr<geodesy::UTMProjection> projection_;
+  double last_easting_, last_northing_, last_heading_;
+
+  std::unique_ptr<OnlineRouteDecimator> decimator_;
+
+  // Waypoints passing the distance/heading thresholds, and written ones
+  size_t accepted_;
+  size_t recorded_;
+  size_t dropped_;
+
+  SpscRingBuffer<Waypoint> buffer_;
+  // Serialized records of one flush, sized once for a full buffer
+  std::vector<char> write_buffer_;
+  int fd_;
+
+  std::thread writer_thread_;
+  std::mutex writer_mutex_;
+  std::condition_variable writer_cv_;
+  std::atomic<bool> stop_;
+};
+
+}  // namespace nav2_gps_route_recorder
+
+#endif  // NAV2_GPS_ROUTE_RECORDER__ROUTE_RECORDER_HPP_
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef NAV2_GPS_ROUTE_RECORDER__SPSC_RING_BUFFER_HPP_
+#define NAV2_GPS_ROUTE_RECORDER__SPSC_RING_BUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace nav2_gps_route_recorder
+{
+
+// Bounded lock-free queue between exactly one producer and one consumer
+// thread. Storage is allocated once at construction: push() and pop() never
+// allocate, and push() fails instead of blocking when the queue is full.
+template<typename T>
+class SpscRingBuffer
+{
+public:
+  explicit SpscRingBuffer(size_t capacity)
+  : slots_(capacity + 1), head_(0), tail_(0)
+  {
+  }
+
+  SpscRingBuffer(const SpscRingBuffer &) = delete;
+  SpscRingBuffer & operator=(const SpscRingBuffer &) = delete;
+
+  // Producer side
+  bool push(const T & item)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t next = tail + 1 == slots_.size() ? 0 : tail + 1;
+    if (next == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slots_[tail] = item;
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side
+  bool pop(T & item)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    item = slots_[head];
+    head_.store(head + 1 == slots_.size() ? 0 : head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate when called concurrently with push() or pop()
+  size_t size() const
+  {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : slots_.size() - head + tail;
+  }
+
+  size_t capacity() const {return slots_.size() - 1;}
+
+private:
+  // One slot is kept free to tell a full queue from an empty one
+  std::vector<T> slots_;
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+};
+
+}  // namespace nav2_gps_route_recorder
+
+#endif  // NAV2_GPS_ROUTE_RECORDER__SPSC_RING_BUFFER_HPP_
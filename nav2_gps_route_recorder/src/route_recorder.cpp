@@ -0,0 +1,252 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "nav2_gps_route_recorder/route_recorder.hpp"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace nav2_gps_route_recorder
+{
+
+namespace
+{
+
+// Waypoint log record, see utils/waypoint_log.py of nav2_gps_waypoint_follower_demo:
+// magic, latitude, longitude, yaw (little endian doubles), crc32 of the doubles
+constexpr char RECORD_MAGIC[4] = {'W', 'P', 'T', '1'};
+constexpr size_t RECORD_SIZE = 32;
+constexpr size_t PAYLOAD_OFFSET = 4;
+constexpr size_t PAYLOAD_SIZE = 24;
+
+}  // namespace
+
+RouteRecorder::RouteRecorder(const rclcpp::NodeOptions & options)
+: rclcpp::Node("route_recorder", "", options),
+  heading_(std::nan("")),
+  accepted_(0),
+  recorded_(0),
+  dropped_(0),
+  buffer_(declare_parameter("buffer_size", 4096)),
+  fd_(-1),
+  stop_(false)
+{
+  const std::string fix_topic = declare_parameter("fix_topic", std::string("gps/filtered"));
+  const std::string imu_topic = declare_parameter("imu_topic", std::string("imu"));
+  std::string output_file = declare_parameter("output_file", std::string("~/gps_route.wplog"));
+  min_distance_ = declare_parameter("min_distance", 1.0);
+  min_heading_change_ = declare_parameter("min_heading_change", 0.26);
+  flush_period_ = std::chrono::duration<double>(declare_parameter("flush_period", 1.0));
+  // Online decimation of the recorded waypoints, disabled with 0.0
+  const double max_cross_track_error = declare_parameter("max_cross_track_error", 0.0);
+  const double max_yaw_change = declare_parameter("max_yaw_change", 0.5);
+  if (max_cross_track_error > 0.0) {
+    decimator_ = std::make_unique<OnlineRouteDecimator>(max_cross_track_error, max_yaw_change);
+  }
+
+  const char * home = std::getenv("HOME");
+  if (output_file.compare(0, 2, "~/") == 0 && home) {
+    output_file = std::string(home) + output_file.substr(1);
+  }
+
+  fd_ = open(output_file.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd_ < 0) {
+    throw std::runtime_error(
+            "Failed to open " + output_file + ": " + std::strerror(errno));
+  }
+  // Drop a record torn by a previous crash, so new records stay aligned
+  struct stat st;
+  if (fstat(fd_, &st) == 0 && st.st_size % RECORD_SIZE != 0) {
+    if (ftruncate(fd_, st.st_size - st.st_size % RECORD_SIZE) != 0) {
+      RCLCPP_WARN(get_logger(), "Failed to truncate a torn record: %s", std::strerror(errno));
+    }
+  }
+  write_buffer_.resize(buffer_.capacity() * RECORD_SIZE);
+
+  fix_sub_ = create_subscription<sensor_msgs::msg::NavSatFix>(
+    fix_topic, rclcpp::SensorDataQoS(),
+    std::bind(&RouteRecorder::fixCallback, this, std::placeholders::_1));
+  imu_sub_ = create_subscription<sensor_msgs::msg::Imu>(
+    imu_topic, rclcpp::SensorDataQoS(),
+    std::bind(&RouteRecorder::imuCallback, this, std::placeholders::_1));
+
+  writer_thread_ = std::thread(&RouteRecorder::writerLoop, this);
+
+  RCLCPP_INFO(
+    get_logger(), "Recording %s with %s heading to %s every %.2f m or %.2f rad",
+    fix_topic.c_str(), imu_topic.c_str(), output_file.c_str(),
+    min_distance_, min_heading_change_);
+}
+
+RouteRecorder::~RouteRecorder()
+{
+  // The end of the route is pending in the decimator
+  RoutePoint last;
+  if (decimator_ && decimator_->finish(last)) {
+    record(Waypoint{last.latitude, last.longitude, last.yaw});
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    stop_ = true;
+  }
+  writer_cv_.notify_one();
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+  RCLCPP_INFO(
+    get_logger(), "Recorded %zu of %zu waypoints, %zu dropped", recorded_, accepted_, dropped_);
+}
+
+void RouteRecorder::imuCallback(const sensor_msgs::msg::Imu::ConstSharedPtr msg)
+{
+  const auto & q = msg->orientation;
+  heading_ = std::atan2(2.0 * (q.w * q.z + q.x * q.y), 1.0 - 2.0 * (q.y * q.y + q.z * q.z));
+}
+
+void RouteRecorder::fixCallback(const sensor_msgs::msg::NavSatFix::ConstSharedPtr msg)
+{
+  if (msg->status.status < sensor_msgs::msg::NavSatStatus::STATUS_FIX || std::isnan(heading_)) {
+    return;
+  }
+
+  // Distances are measured in the UTM zone of the first fix
+  if (!projection_) {
+    projection_ = std::make_unique<geodesy::UTMProjection>(
+      geodesy::UTMProjection::forPoint(msg->latitude, msg->longitude));
+  }
+  double easting, northing;
+  projection_->forward(msg->latitude, msg->longitude, easting, northing);
+
+  if (accepted_ > 0) {
+    const double distance = std::hypot(easting - last_easting_, northing - last_northing_);
+    const double turn = std::abs(std::remainder(heading_ - last_heading_, 2.0 * M_PI));
+    if (distance < min_distance_ && turn < min_heading_change_) {
+      return;
+    }
+  }
+
+  last_easting_ = easting;
+  last_northing_ = northing;
+  last_heading_ = heading_;
+  ++accepted_;
+
+  if (!decimator_) {
+    record(Waypoint{msg->latitude, msg->longitude, heading_});
+    return;
+  }
+  RoutePoint emitted;
+  if (decimator_->add(
+      RoutePoint{easting, northing, heading_, msg->latitude, msg->longitude}, emitted))
+  {
+    record(Waypoint{emitted.latitude, emitted.longitude, emitted.yaw});
+  }
+}
+
+void RouteRecorder::record(const Waypoint & waypoint)
+{
+  if (!buffer_.push(waypoint)) {
+    ++dropped_;
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000, "Route buffer full, %zu waypoints dropped", dropped_);
+    return;
+  }
+  ++recorded_;
+
+  if (buffer_.size() >= buffer_.capacity() / 2) {
+    writer_cv_.notify_one();
+  }
+}
+
+void RouteRecorder::writerLoop()
+{
+  while (!stop_) {
+    {
+      std::unique_lock<std::mutex> lock(writer_mutex_);
+      writer_cv_.wait_for(
+        lock, flush_period_, [this]() {
+          return stop_ || buffer_.size() >= buffer_.capacity() / 2;
+        });
+    }
+    if (!flush()) {
+      RCLCPP_ERROR(get_logger(), "Failed to write the route: %s", std::strerror(errno));
+    }
+  }
+  // Waypoints queued before stopping
+  flush();
+}
+
+bool RouteRecorder::flush()
+{
+  // Records are serialized in place, assuming a little endian host
+  size_t count = 0;
+  Waypoint wp;
+  while (count < buffer_.capacity() && buffer_.pop(wp)) {
+    char * record = write_buffer_.data() + count * RECORD_SIZE;
+    std::memcpy(record, RECORD_MAGIC, sizeof(RECORD_MAGIC));
+    std::memcpy(record + PAYLOAD_OFFSET, &wp.latitude, sizeof(double));
+    std::memcpy(record + PAYLOAD_OFFSET + 8, &wp.longitude, sizeof(double));
+    std::memcpy(record + PAYLOAD_OFFSET + 16, &wp.yaw, sizeof(double));
+    const uint32_t crc = crc32(
+      0L, reinterpret_cast<const Bytef *>(record + PAYLOAD_OFFSET), PAYLOAD_SIZE);
+    std::memcpy(record + PAYLOAD_OFFSET + PAYLOAD_SIZE, &crc, sizeof(crc));
+    ++count;
+  }
+  if (count == 0) {
+    return true;
+  }
+
+  const char * data = write_buffer_.data();
+  size_t remaining = count * RECORD_SIZE;
+  while (remaining > 0) {
+    const ssize_t written = write(fd_, data, remaining);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    remaining -= static_cast<size_t>(written);
+  }
+  return fdatasync(fd_) == 0;
+}
+
+}  // namespace nav2_gps_route_recorder
+
+#include "rclcpp_components/register_node_macro.hpp"
+
+// Register the component with class_loader.
+// This acts as a sort of entry point, allowing the component to be discoverable when its library
+// is being loaded into a running process.
+RCLCPP_COMPONENTS_REGISTER_NODE(nav2_gps_route_recorder::RouteRecorder)
@@ -0,0 +1,180 @@
+// Copyright (c) 2026 navigation2_tutorials contributors
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef NAV2_GPS_WAYPOINT_FOLLOWER_DEMO__WAYPOINT_ROUTE_HPP_
+#define NAV2_GPS_WAYPOINT_FOLLOWER_DEMO__WAYPOINT_ROUTE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+// Reader of the binary GPS route files written by waypoints_to_route (see
+// utils/waypoint_route.py for the writer). The file is memory mapped and the
+// waypoints are used in place, so opening a route costs the same whatever its
+// length and pages are only loaded as they are read.
+
+namespace nav2_gps_waypoint_follower_demo
+{
+
+constexpr char ROUTE_MAGIC[8] = {'N', '2', 'G', 'P', 'S', 'W', 'P', 'T'};
+constexpr uint32_t ROUTE_VERSION = 1;
+
+struct WaypointRouteHeader
+{
+  char magic[8];
+  uint32_t version;
+  // Number of waypoints per index entry
+  uint32_t block_size;
+  uint64_t count;
+  uint64_t index_offset;
+  uint64_t data_offset;
+};
+
+// Bounding box of block_size consecutive waypoints
+struct WaypointBlockBounds
+{
+  double min_lat;
+  double min_lon;
+  double max_lat;
+  double max_lon;
+};
+
+struct Waypoint
+{
+  double latitude;
+  double longitude;
+  double yaw;
+};
+
+static_assert(sizeof(WaypointRouteHeader) == 40, "Unexpected route header layout");
+static_assert(sizeof(WaypointBlockBounds) == 32, "Unexpected route index layout");
+static_assert(sizeof(Waypoint) == 24, "Unexpected route waypoint layout");
+
+class WaypointRoute
+{
+public:
+  // Throws std::runtime_error if the file can not be mapped or is not a route
+  explicit WaypointRoute(const std::string & filename)
+  {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open " + filename + ": " + std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(WaypointRouteHeader))) {
+      close(fd);
+      throw std::runtime_error(filename + " is too short to be a route");
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void * data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+      throw std::runtime_error("Failed to map " + filename + ": " + std::strerror(errno));
+    }
+    data_ = static_cast<const char *>(data);
+
+    const auto * header = reinterpret_cast<const WaypointRouteHeader *>(data_);
+    const uint64_t blocks = header->block_size ?
+      (header->count + header->block_size - 1) / header->block_size : 0;
+    if (std::memcmp(header->magic, ROUTE_MAGIC, sizeof(ROUTE_MAGIC)) != 0 ||
+      header->version != ROUTE_VERSION || header->block_size == 0 ||
+      header->index_offset + blocks * sizeof(WaypointBlockBounds) > size_ ||
+      header->data_offset + header->count * sizeof(Waypoint) > size_)
+    {
+      munmap(const_cast<char *>(data_), size_);
+      throw std::runtime_error(filename + " is not a valid version 1 route");
+    }
+    header_ = header;
+    bounds_ = reinterpret_cast<const WaypointBlockBounds *>(data_ + header->index_offset);
+    waypoints_ = reinterpret_cast<const Waypoint *>(data_ + header->data_offset);
+    blocks_ = static_cast<size_t>(blocks);
+  }
+
+  ~WaypointRoute()
+  {
+    munmap(const_cast<char *>(data_), size_);
+  }
+
+  WaypointRoute(const WaypointRoute &) = delete;
+  WaypointRoute & operator=(const WaypointRoute &) = delete;
+
+  size_t size() const {return static_cast<size_t>(header_->count);}
+  const Waypoint & operator[](size_t i) const {return waypoints_[i];}
+  const Waypoint * begin() const {return waypoints_;}
+  const Waypoint * end() const {return waypoints_ + size();}
+
+  size_t blockSize() const {return header_->block_size;}
+  size_t blocks() const {return blocks_;}
+  const WaypointBlockBounds & blockBounds(size_t block) const {return bounds_[block];}
+
+  // Index of the waypoint closest to (latitude, longitude), size() for an
+  // empty route. Blocks whose bounding box is farther than the best waypoint
+  // found so far are skipped without touching their waypoints.
+  size_t nearest(double latitude, double longitude) const
+  {
+    // Equirectangular distances in degrees of latitude
+    const double scale = std::cos(latitude * M_PI / 180.0);
+    size_t best = size();
+    double best_dist = std::numeric_limits<double>::infinity();
+    for (size_t b = 0; b < blocks_; ++b) {
+      const WaypointBlockBounds & bb = bounds_[b];
+      const double dlat = std::max({bb.min_lat - latitude, latitude - bb.max_lat, 0.0});
+      const double dlon = std::max({bb.min_lon - longitude, longitude - bb.max_lon, 0.0}) * scale;
+      if (dlat * dlat + dlon * dlon >= best_dist) {
+        continue;
+      }
+
+      const size_t first = b * blockSize();
+      const size_t last = std::min(first + blockSize(), size());
+      for (size_t i = first; i < last; ++i) {
+        const double wlat = waypoints_[i].latitude - latitude;
+        const double wlon = (waypoints_[i].longitude - longitude) * scale;
+        const double dist = wlat * wlat + wlon * wlon;
+        if (dist < best_dist) {
+          best = i;
+          best_dist = dist;
+        }
+      }
+    }
+    return best;
+  }
+
+private:
+  const char * data_;
+  size_t size_;
+  const WaypointRouteHeader * header_;
+  const WaypointBlockBounds * bounds_;
+  const Waypoint * waypoints_;
+  size_t blocks_;
+};
+
+}  // namespace nav2_gps_waypoint_follower_demo
+
+#endif  // NAV2_GPS_WAYPOINT_FOLLOWER_DEMO__WAYPOINT_ROUTE_HPP_
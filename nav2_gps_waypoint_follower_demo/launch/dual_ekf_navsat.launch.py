@@ -15,6 +15,7 @@ from launch import LaunchDescription
 from ament_index_python.packages import get_package_share_directory
 from launch.actions import IncludeLaunchDescription
 from launch.launch_description_sources import PythonLaunchDescriptionSource
+from launch.substitutions import LaunchConfiguration
 import launch_ros.actions
 import os
 import launch.actions
@@ -25,9 +26,13 @@ def generate_launch_description():
         "nav2_gps_waypoint_follower_demo")
     rl_params_file = os.path.join(
         gps_wpf_dir, "config", "dual_ekf_navsat_params.yaml")
+    use_sim_time = LaunchConfiguration("use_sim_time")
 
     return LaunchDescription(
         [
+            launch.actions.DeclareLaunchArgument(
+                "use_sim_time", default_value="True"
+            ),
             launch.actions.DeclareLaunchArgument(
                 "output_final_position", default_value="false"
             ),
@@ -39,7 +44,7 @@ def generate_launch_description():
                 executable="ekf_node",
                 name="ekf_filter_node_odom",
                 output="screen",
-                parameters=[rl_params_file, {"use_sim_time": True}],
+                parameters=[rl_params_file, {"use_sim_time": use_sim_time}],
                 remappings=[("odometry/filtered", "odometry/local")],
             ),
             launch_ros.actions.Node(
@@ -47,7 +52,7 @@ def generate_launch_description():
                 executable="ekf_node",
                 name="ekf_filter_node_map",
                 output="screen",
-                parameters=[rl_params_file, {"use_sim_time": True}],
+                parameters=[rl_params_file, {"use_sim_time": use_sim_time}],
                 remappings=[("odometry/filtered", "odometry/global")],
             ),
             launch_ros.actions.Node(
@@ -55,7 +60,7 @@ def generate_launch_description():
                 executable="navsat_transform_node",
                 name="navsat_transform",
                 output="screen",
-                parameters=[rl_params_file, {"use_sim_time": True}],
+                parameters=[rl_params_file, {"use_sim_time": use_sim_time}],
                 remappings=[
                     ("imu/data", "imu/data"),
                     ("gps/fix", "gps/fix"),
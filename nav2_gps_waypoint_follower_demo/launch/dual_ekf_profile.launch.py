@@ -0,0 +1,148 @@
+# Copyright (c) 2026 navigation2_tutorials contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+from ament_index_python.packages import get_package_share_directory
+
+from launch import LaunchDescription
+from launch.actions import DeclareLaunchArgument, EmitEvent, ExecuteProcess, RegisterEventHandler
+from launch.event_handlers import OnProcessExit
+from launch.events import Shutdown
+from launch.substitutions import LaunchConfiguration
+from launch_ros.actions import Node
+from launch_ros.parameter_descriptions import ParameterValue
+
+
+def generate_launch_description():
+    # Replays a bag of odom, imu and gps/fix into the dual EKF setup of
+    # dual_ekf_navsat.launch.py, with the filter frequency and the sensor queue sizes
+    # overridden, while ekf_profiler measures the filters. Everything shuts down with the bag
+    gps_wpf_dir = get_package_share_directory(
+        "nav2_gps_waypoint_follower_demo")
+    rl_params_file = os.path.join(
+        gps_wpf_dir, "config", "dual_ekf_navsat_params.yaml")
+
+    urdf = os.path.join(gps_wpf_dir, 'urdf', 'turtlebot3_waffle_gps.urdf')
+    with open(urdf, 'r') as infp:
+        robot_description = infp.read()
+
+    bag = LaunchConfiguration('bag')
+    rate = LaunchConfiguration('rate')
+    frequency = ParameterValue(LaunchConfiguration('frequency'), value_type=float)
+    queue_size = ParameterValue(LaunchConfiguration('queue_size'), value_type=int)
+    report_file = LaunchConfiguration('report_file')
+
+    declare_bag_cmd = DeclareLaunchArgument(
+        'bag',
+        description='Bag with the odom, imu and gps/fix topics to replay')
+
+    declare_rate_cmd = DeclareLaunchArgument(
+        'rate',
+        default_value='1.0',
+        description='Replay rate of the bag')
+
+    declare_frequency_cmd = DeclareLaunchArgument(
+        'frequency',
+        default_value='30.0',
+        description='Frequency of both EKFs')
+
+    declare_queue_size_cmd = DeclareLaunchArgument(
+        'queue_size',
+        default_value='10',
+        description='Queue size of every EKF sensor input')
+
+    declare_report_file_cmd = DeclareLaunchArgument(
+        'report_file',
+        default_value='~/dual_ekf_profile.yaml',
+        description='Where to write the profile')
+
+    ekf_overrides = {
+        'use_sim_time': True,
+        'frequency': frequency,
+        'odom0_queue_size': queue_size,
+        'odom1_queue_size': queue_size,
+        'imu0_queue_size': queue_size,
+    }
+
+    robot_state_publisher_cmd = Node(
+        package='robot_state_publisher',
+        executable='robot_state_publisher',
+        name='robot_state_publisher',
+        output='both',
+        parameters=[{'robot_description': robot_description, 'use_sim_time': True}])
+
+    ekf_odom_cmd = Node(
+        package="robot_localization",
+        executable="ekf_node",
+        name="ekf_filter_node_odom",
+        output="screen",
+        parameters=[rl_params_file, ekf_overrides],
+        remappings=[("odometry/filtered", "odometry/local")])
+
+    ekf_map_cmd = Node(
+        package="robot_localization",
+        executable="ekf_node",
+        name="ekf_filter_node_map",
+        output="screen",
+        parameters=[rl_params_file, ekf_overrides],
+        remappings=[("odometry/filtered", "odometry/global")])
+
+    navsat_transform_cmd = Node(
+        package="robot_localization",
+        executable="navsat_transform_node",
+        name="navsat_transform",
+        output="screen",
+        parameters=[rl_params_file, {'use_sim_time': True}],
+        remappings=[("odometry/filtered", "odometry/global")])
+
+    profiler_cmd = Node(
+        package='nav2_gps_waypoint_follower_demo',
+        executable='ekf_profiler',
+        name='ekf_profiler',
+        output='screen',
+        parameters=[{'use_sim_time': True, 'frequency': frequency,
+                     'rate': ParameterValue(rate, value_type=float),
+                     'queue_size': queue_size, 'report_file': report_file}])
+
+    bag_play_cmd = ExecuteProcess(
+        cmd=['ros2', 'bag', 'play', bag, '--clock', '--rate', rate,
+             '--topics', 'odom', 'imu', 'gps/fix'],
+        output='screen')
+
+    shutdown_on_bag_end_cmd = RegisterEventHandler(
+        OnProcessExit(target_action=bag_play_cmd,
+                      on_exit=[EmitEvent(event=Shutdown(reason='bag replay finished'))]))
+
+    # Create the launch description and populate
+    ld = LaunchDescription()
+
+    ld.add_action(declare_bag_cmd)
+    ld.add_action(declare_rate_cmd)
+    ld.add_action(declare_frequency_cmd)
+    ld.add_action(declare_queue_size_cmd)
+    ld.add_action(declare_report_file_cmd)
+
+    # filters under test
+    ld.add_action(robot_state_publisher_cmd)
+    ld.add_action(ekf_odom_cmd)
+    ld.add_action(ekf_map_cmd)
+    ld.add_action(navsat_transform_cmd)
+
+    # profiler and replay launch
+    ld.add_action(profiler_cmd)
+    ld.add_action(bag_play_cmd)
+    ld.add_action(shutdown_on_bag_end_cmd)
+
+    return ld
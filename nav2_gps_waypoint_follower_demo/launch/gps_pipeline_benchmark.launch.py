@@ -0,0 +1,113 @@
+# Copyright (c) 2026 navigation2_tutorials contributors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+from ament_index_python.packages import get_package_share_directory
+
+from launch import LaunchDescription
+from launch.substitutions import LaunchConfiguration
+from launch.actions import IncludeLaunchDescription, DeclareLaunchArgument
+from launch.launch_description_sources import PythonLaunchDescriptionSource
+from launch_ros.actions import Node
+from nav2_common.launch import RewrittenYaml
+
+
+def generate_launch_description():
+    # Headless version of gps_waypoint_follower.launch.py: gazebo is replaced by
+    # gnss_simulator and gps_pipeline_benchmark drives the robot and reports latencies
+    bringup_dir = get_package_share_directory('nav2_bringup')
+    gps_wpf_dir = get_package_share_directory(
+        "nav2_gps_waypoint_follower_demo")
+    launch_dir = os.path.join(gps_wpf_dir, 'launch')
+    params_dir = os.path.join(gps_wpf_dir, "config")
+    nav2_params = os.path.join(params_dir, "nav2_no_map_params.yaml")
+    configured_params = RewrittenYaml(
+        source_file=nav2_params, root_key="", param_rewrites="", convert_types=True
+    )
+
+    urdf = os.path.join(gps_wpf_dir, 'urdf', 'turtlebot3_waffle_gps.urdf')
+    with open(urdf, 'r') as infp:
+        robot_description = infp.read()
+
+    runs = LaunchConfiguration('runs')
+    report_file = LaunchConfiguration('report_file')
+
+    declare_runs_cmd = DeclareLaunchArgument(
+        'runs',
+        default_value='10',
+        description='Number of gps waypoints sent by the benchmark')
+
+    declare_report_file_cmd = DeclareLaunchArgument(
+        'report_file',
+        default_value='~/gps_pipeline_benchmark.txt',
+        description='Where to write the latency report')
+
+    gnss_simulator_cmd = Node(
+        package='nav2_gps_waypoint_follower_demo',
+        executable='gnss_simulator',
+        name='gnss_simulator',
+        output='screen')
+
+    robot_state_publisher_cmd = Node(
+        package='robot_state_publisher',
+        executable='robot_state_publisher',
+        name='robot_state_publisher',
+        output='both',
+        parameters=[{'robot_description': robot_description}])
+
+    robot_localization_cmd = IncludeLaunchDescription(
+        PythonLaunchDescriptionSource(
+            os.path.join(launch_dir, 'dual_ekf_navsat.launch.py')),
+        launch_arguments={"use_sim_time": "False"}.items(),
+    )
+
+    navigation2_cmd = IncludeLaunchDescription(
+        PythonLaunchDescriptionSource(
+            os.path.join(bringup_dir, "launch", "navigation_launch.py")
+        ),
+        launch_arguments={
+            "use_sim_time": "False",
+            "params_file": configured_params,
+            "autostart": "True",
+        }.items(),
+    )
+
+    benchmark_cmd = Node(
+        package='nav2_gps_waypoint_follower_demo',
+        executable='gps_pipeline_benchmark',
+        name='gps_pipeline_benchmark',
+        output='screen',
+        parameters=[{'runs': runs, 'report_file': report_file}])
+
+    # Create the launch description and populate
+    ld = LaunchDescription()
+
+    ld.add_action(declare_runs_cmd)
+    ld.add_action(declare_report_file_cmd)
+
+    # simulated sensors launch
+    ld.add_action(gnss_simulator_cmd)
+    ld.add_action(robot_state_publisher_cmd)
+
+    # robot localization launch
+    ld.add_action(robot_localization_cmd)
+
+    # navigation2 launch
+    ld.add_action(navigation2_cmd)
+
+    # benchmark launch
+    ld.add_action(benchmark_cmd)
+
+    return ld
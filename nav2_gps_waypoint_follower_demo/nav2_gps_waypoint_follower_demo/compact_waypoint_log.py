@@ -0,0 +1,23 @@
+import sys
+
+from nav2_gps_waypoint_follower_demo.utils.waypoint_log import read_waypoint_log
+from nav2_gps_waypoint_follower_demo.utils.waypoint_route import ROUTE_EXTENSION, write_waypoints
+
+
+def main():
+    """
+    Compacts a waypoint log into the waypoint followers input, a demo_waypoints.yaml
+    layout yaml or a binary route depending on the output extension
+    """
+    if len(sys.argv) < 3:
+        print(f"Usage: compact_waypoint_log <log.wplog> <output.yaml|output{ROUTE_EXTENSION}>")
+        sys.exit(1)
+
+    log_file_path, output_file_path = sys.argv[1], sys.argv[2]
+    latitudes, longitudes, yaws = read_waypoint_log(log_file_path)
+    write_waypoints(output_file_path, latitudes, longitudes, yaws)
+    print(f"Wrote {len(latitudes)} waypoints to {output_file_path}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,28 @@
+import sys
+
+from nav2_gps_waypoint_follower_demo.logged_waypoint_follower import make_waypoint_parser
+from nav2_gps_waypoint_follower_demo.utils.waypoint_route import write_waypoints
+
+
+def main():
+    """
+    Decimates a waypoints file (yaml or binary route) to a new yaml or binary route
+    """
+    if len(sys.argv) < 4:
+        print("Usage: decimate_route <input> <output> <max_cross_track_error> [max_yaw_change]")
+        sys.exit(1)
+
+    input_file_path, output_file_path = sys.argv[1], sys.argv[2]
+    max_cross_track_error = float(sys.argv[3])
+    max_yaw_change = float(sys.argv[4]) if len(sys.argv) > 4 else 0.5
+
+    wp_parser = make_waypoint_parser(input_file_path, max_cross_track_error, max_yaw_change)
+    # The decimated parser wraps the input one
+    input_count = len(wp_parser.wp_parser if max_cross_track_error > 0.0 else wp_parser)
+    latitudes, longitudes, yaws = wp_parser.get_arrays()
+    write_waypoints(output_file_path, latitudes, longitudes, yaws)
+    print(f"Kept {len(latitudes)} of {input_count} waypoints in {output_file_path}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,168 @@
+import math
+import os
+import time
+
+import numpy as np
+import rclpy
+import yaml
+from rclpy.executors import ExternalShutdownException
+from rclpy.node import Node
+from nav_msgs.msg import Odometry
+
+# Filter nodes of dual_ekf_navsat.launch.py and the outputs they are remapped to
+FILTERS = {"ekf_filter_node_odom": "odometry/local", "ekf_filter_node_map": "odometry/global"}
+
+
+def find_node_pid(node_name: str):
+    """
+    Pid of the process launched with the given node name, None if there is none
+    """
+    remap = f"__node:={node_name}".encode()
+    for pid in filter(str.isdigit, os.listdir("/proc")):
+        try:
+            with open(f"/proc/{pid}/cmdline", "rb") as cmdline:
+                if remap in cmdline.read().split(b"\0"):
+                    return int(pid)
+        except OSError:
+            continue
+    return None
+
+
+def process_cpu_time(pid: int) -> float:
+    """
+    User plus system CPU time of a process, in seconds
+    """
+    with open(f"/proc/{pid}/stat", "r") as stat:
+        # Fields after the executable name, which may hold spaces
+        fields = stat.read().rsplit(")", 1)[1].split()
+    return (int(fields[11]) + int(fields[12])) / os.sysconf("SC_CLK_TCK")
+
+
+class FilterStats:
+    """
+    Output timing and process CPU time of one filter node. Outputs are timed on receipt with
+    the monotonic wall clock: their stamps are sim time, spaced by the measurements and the
+    /clock rate rather than by the filter scheduling
+    """
+
+    def __init__(self, node_name: str):
+        self.node_name = node_name
+        self.pid = None
+        self.receipts = []
+        self.start_cpu = None
+        self.end_cpu = None
+
+    def add(self):
+        if self.pid is None:
+            self.pid = find_node_pid(self.node_name)
+            if self.pid is None:
+                return
+        try:
+            cpu = process_cpu_time(self.pid)
+        except OSError:
+            return
+        if self.start_cpu is None:
+            self.start_cpu = cpu
+        self.end_cpu = cpu
+        self.receipts.append(time.monotonic())
+
+    def report(self, wall_frequency: float):
+        updates = len(self.receipts) - 1
+        if updates < 1:
+            return {"updates": 0}
+        periods = np.diff(self.receipts)
+        deviations = np.abs(periods - 1.0 / wall_frequency) * 1e3
+        cpu = self.end_cpu - self.start_cpu
+        return {
+            "updates": updates,
+            "cpu_per_update_ms": float(cpu / updates * 1e3),
+            "cpu_load": float(cpu / (self.receipts[-1] - self.receipts[0])),
+            "period_mean_ms": float(periods.mean() * 1e3),
+            "jitter_std_ms": float(periods.std() * 1e3),
+            "jitter_p99_ms": float(np.percentile(deviations, 99)),
+            "jitter_max_ms": float(deviations.max()),
+        }
+
+
+class EkfProfiler(Node):
+    """
+    Profiles the dual EKF setup while recorded sensor data is replayed into it. For each
+    filter, the CPU time of its process is divided over its outputs, one per filter update,
+    and the output periods give the jitter against the configured frequency, both in wall
+    time at the bag replay rate. Accuracy is the RMS horizontal distance between
+    odometry/global and the navsat_transform gps positions. The first warmup seconds, while
+    navsat_transform waits for its datum, are not profiled
+    """
+
+    def __init__(self):
+        super().__init__(node_name="ekf_profiler")
+        self.declare_parameter("frequency", 30.0)
+        self.declare_parameter("rate", 1.0)
+        self.declare_parameter("queue_size", 10)
+        self.declare_parameter("warmup", 5.0)
+        self.declare_parameter("report_file", "~/dual_ekf_profile.yaml")
+        self.frequency = self.get_parameter("frequency").value
+        self.rate = self.get_parameter("rate").value
+        self.warmup = self.get_parameter("warmup").value
+
+        self.start_stamp = None
+        self.filters = {}
+        for node_name, topic in FILTERS.items():
+            stats = FilterStats(node_name)
+            self.filters[node_name] = stats
+            self.create_subscription(
+                Odometry, topic, lambda msg, stats=stats: self.filter_cb(msg, stats), 100)
+        self.last_global = None
+        self.gps_errors_sq = []
+        self.create_subscription(Odometry, "odometry/gps", self.gps_cb, 100)
+
+    def profiling(self, msg: Odometry):
+        stamp = msg.header.stamp.sec + msg.header.stamp.nanosec * 1e-9
+        if self.start_stamp is None:
+            self.start_stamp = stamp
+        return stamp if stamp - self.start_stamp >= self.warmup else None
+
+    def filter_cb(self, msg: Odometry, stats: FilterStats):
+        if self.profiling(msg) is None:
+            return
+        stats.add()
+        if stats.node_name == "ekf_filter_node_map":
+            self.last_global = msg.pose.pose.position
+
+    def gps_cb(self, msg: Odometry):
+        if self.profiling(msg) is None or self.last_global is None:
+            return
+        dx = msg.pose.pose.position.x - self.last_global.x
+        dy = msg.pose.pose.position.y - self.last_global.y
+        self.gps_errors_sq.append(dx * dx + dy * dy)
+
+    def write_report(self):
+        report = {
+            "frequency": self.frequency,
+            "rate": self.rate,
+            "queue_size": self.get_parameter("queue_size").value,
+            # The filters run at frequency in sim time, replayed rate times faster
+            "filters": {name: stats.report(self.frequency * self.rate)
+                        for name, stats in self.filters.items()},
+            "gps_rms_error_m": float(math.sqrt(np.mean(self.gps_errors_sq)))
+            if self.gps_errors_sq else None,
+        }
+        report_file = os.path.expanduser(self.get_parameter("report_file").value)
+        with open(report_file, 'w') as report_out:
+            yaml.dump(report, report_out, sort_keys=False)
+        self.get_logger().info(f"Profile written to {report_file}")
+
+
+def main():
+    rclpy.init()
+    profiler = EkfProfiler()
+    # Runs until the launch file shuts everything down at the end of the replay
+    try:
+        rclpy.spin(profiler)
+    except (KeyboardInterrupt, ExternalShutdownException):
+        pass
+    profiler.write_report()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,126 @@
+import math
+
+import rclpy
+from rclpy.node import Node
+from geometry_msgs.msg import Twist
+from nav_msgs.msg import Odometry
+from sensor_msgs.msg import Imu, LaserScan, NavSatFix, NavSatStatus
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import (
+    enu_to_lat_lon, quaternion_from_euler)
+
+
+class GnssSimulator(Node):
+    """
+    Headless stand-in for the gazebo world: integrates cmd_vel as a unicycle and publishes the
+    odom, imu and gps/fix streams the dual EKF setup consumes, plus an empty scan for the
+    costmaps. The robot starts at the origin latitude/longitude facing east
+    """
+
+    def __init__(self):
+        super().__init__(node_name="gnss_simulator")
+        self.declare_parameter("origin_latitude", 38.161479)
+        self.declare_parameter("origin_longitude", -122.454630)
+        self.declare_parameter("odom_rate", 50.0)
+        self.declare_parameter("imu_rate", 50.0)
+        self.declare_parameter("gps_rate", 10.0)
+        self.declare_parameter("scan_rate", 10.0)
+
+        self.origin_latitude = self.get_parameter("origin_latitude").value
+        self.origin_longitude = self.get_parameter("origin_longitude").value
+
+        # Ground truth pose in the ENU frame of the origin
+        self.x = 0.0
+        self.y = 0.0
+        self.yaw = 0.0
+        self.cmd_vel = Twist()
+        self.last_update = self.get_clock().now()
+
+        self.odom_pub = self.create_publisher(Odometry, "odom", 10)
+        self.imu_pub = self.create_publisher(Imu, "imu", 10)
+        self.fix_pub = self.create_publisher(NavSatFix, "gps/fix", 10)
+        self.scan_pub = self.create_publisher(LaserScan, "scan", 10)
+        self.cmd_vel_sub = self.create_subscription(Twist, "cmd_vel", self.cmd_vel_cb, 10)
+
+        self.create_timer(1.0 / self.get_parameter("odom_rate").value, self.odom_cb)
+        self.create_timer(1.0 / self.get_parameter("imu_rate").value, self.imu_cb)
+        self.create_timer(1.0 / self.get_parameter("gps_rate").value, self.gps_cb)
+        self.create_timer(1.0 / self.get_parameter("scan_rate").value, self.scan_cb)
+
+    def cmd_vel_cb(self, msg: Twist):
+        self.update()
+        self.cmd_vel = msg
+
+    def update(self):
+        """
+        Integrates the last velocity command up to now
+        """
+        now = self.get_clock().now()
+        dt = (now - self.last_update).nanoseconds * 1e-9
+        self.last_update = now
+        self.yaw += self.cmd_vel.angular.z * dt
+        self.x += self.cmd_vel.linear.x * math.cos(self.yaw) * dt
+        self.y += self.cmd_vel.linear.x * math.sin(self.yaw) * dt
+
+    def odom_cb(self):
+        self.update()
+        msg = Odometry()
+        msg.header.stamp = self.last_update.to_msg()
+        msg.header.frame_id = "odom"
+        msg.child_frame_id = "base_footprint"
+        msg.pose.pose.position.x = self.x
+        msg.pose.pose.position.y = self.y
+        msg.pose.pose.orientation = quaternion_from_euler(0.0, 0.0, self.yaw)
+        msg.twist.twist = self.cmd_vel
+        msg.twist.covariance[0] = msg.twist.covariance[7] = msg.twist.covariance[35] = 1e-3
+        self.odom_pub.publish(msg)
+
+    def imu_cb(self):
+        msg = Imu()
+        msg.header.stamp = self.get_clock().now().to_msg()
+        msg.header.frame_id = "imu_link"
+        msg.orientation = quaternion_from_euler(0.0, 0.0, self.yaw)
+        msg.orientation_covariance[0] = msg.orientation_covariance[4] = 1e-6
+        msg.orientation_covariance[8] = 1e-6
+        msg.angular_velocity.z = self.cmd_vel.angular.z
+        msg.linear_acceleration.z = 9.81
+        self.imu_pub.publish(msg)
+
+    def gps_cb(self):
+        latitude, longitude, _ = enu_to_lat_lon(
+            self.x, self.y, self.origin_latitude, self.origin_longitude)
+        msg = NavSatFix()
+        msg.header.stamp = self.get_clock().now().to_msg()
+        msg.header.frame_id = "gps_link"
+        msg.status.status = NavSatStatus.STATUS_FIX
+        msg.status.service = NavSatStatus.SERVICE_GPS
+        msg.latitude = float(latitude)
+        msg.longitude = float(longitude)
+        msg.position_covariance[0] = msg.position_covariance[4] = 1e-4
+        msg.position_covariance[8] = 1e-4
+        msg.position_covariance_type = NavSatFix.COVARIANCE_TYPE_DIAGONAL_KNOWN
+        self.fix_pub.publish(msg)
+
+    def scan_cb(self):
+        """
+        Publishes a scan without returns, so the costmap observation sources stay current
+        """
+        msg = LaserScan()
+        msg.header.stamp = self.get_clock().now().to_msg()
+        msg.header.frame_id = "base_scan"
+        msg.angle_min = -math.pi
+        msg.angle_max = math.pi
+        msg.angle_increment = math.pi / 180.0
+        msg.range_min = 0.12
+        msg.range_max = 3.5
+        msg.ranges = [math.inf] * 360
+        self.scan_pub.publish(msg)
+
+
+def main():
+    rclpy.init()
+    gnss_simulator = GnssSimulator()
+    rclpy.spin(gnss_simulator)
+
+
+if __name__ == "__main__":
+    main()
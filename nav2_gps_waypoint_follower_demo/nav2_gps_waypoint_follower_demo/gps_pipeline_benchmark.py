@@ -0,0 +1,167 @@
+import math
+import os
+import time
+
+import numpy as np
+import rclpy
+from rclpy.node import Node
+from rclpy.task import Future
+from geometry_msgs.msg import Twist
+from nav_msgs.msg import Odometry, Path
+from nav2_simple_commander.robot_navigator import BasicNavigator
+from sensor_msgs.msg import NavSatFix
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import enu_to_lat_lon, latLonYaw2Geopose
+from nav2_gps_waypoint_follower_demo.utils.gps_waypoint_client import GpsWaypointClient
+
+
+class GpsPipelineBenchmark(Node):
+    """
+    Measures the latency of the GPS waypoint pipeline. Every run sends a gps waypoint
+    goal_distance meters from the robot and times, on arrival of the messages:
+      - navsat: gps/fix to the odometry/gps conversion of navsat_transform (all fixes)
+      - goal_to_plan: goal sent to the first global plan
+      - plan_to_cmd_vel: first plan to the first non zero controller command
+      - goal_to_cmd_vel: end to end, goal sent to the first command
+    The run is then canceled and the next one starts after settle_time
+    """
+
+    def __init__(self):
+        super().__init__(node_name="gps_pipeline_benchmark")
+        self.declare_parameter("runs", 10)
+        self.declare_parameter("goal_distance", 5.0)
+        self.declare_parameter("settle_time", 2.0)
+        self.declare_parameter("run_timeout", 30.0)
+        self.declare_parameter("report_file", "~/gps_pipeline_benchmark.txt")
+        self.runs = self.get_parameter("runs").value
+        self.goal_distance = self.get_parameter("goal_distance").value
+        self.settle_time = self.get_parameter("settle_time").value
+        self.run_timeout = self.get_parameter("run_timeout").value
+
+        self.client = GpsWaypointClient(self)
+        self.done = Future()
+        self.samples = {"navsat": [], "goal_to_plan": [], "plan_to_cmd_vel": [],
+                        "goal_to_cmd_vel": []}
+        self.failed_runs = 0
+
+        # Arrival times of the fixes not converted yet, by stamp
+        self.fix_arrivals = {}
+        self.last_fix = None
+        self.run = 0
+        self.goal_time = None
+        self.plan_time = None
+        self.timer = None
+
+        self.create_subscription(NavSatFix, "gps/fix", self.fix_cb, 10)
+        self.create_subscription(Odometry, "odometry/gps", self.navsat_cb, 10)
+        self.create_subscription(Path, "plan", self.plan_cb, 10)
+        self.create_subscription(Twist, "cmd_vel", self.cmd_vel_cb, 10)
+
+    def fix_cb(self, msg: NavSatFix):
+        self.last_fix = msg
+        stamp = (msg.header.stamp.sec, msg.header.stamp.nanosec)
+        self.fix_arrivals[stamp] = time.monotonic()
+        # Fixes navsat_transform never converted, e.g. before the datum is set
+        if len(self.fix_arrivals) > 100:
+            self.fix_arrivals.pop(next(iter(self.fix_arrivals)))
+
+    def navsat_cb(self, msg: Odometry):
+        arrival = self.fix_arrivals.pop((msg.header.stamp.sec, msg.header.stamp.nanosec), None)
+        if arrival is not None:
+            self.samples["navsat"].append(time.monotonic() - arrival)
+
+    def plan_cb(self, msg: Path):
+        if self.goal_time is not None and self.plan_time is None:
+            self.plan_time = time.monotonic()
+
+    def cmd_vel_cb(self, msg: Twist):
+        if self.goal_time is None or self.plan_time is None:
+            return
+        if msg.linear.x == 0.0 and msg.angular.z == 0.0:
+            return
+        now = time.monotonic()
+        self.samples["goal_to_plan"].append(self.plan_time - self.goal_time)
+        self.samples["plan_to_cmd_vel"].append(now - self.plan_time)
+        self.samples["goal_to_cmd_vel"].append(now - self.goal_time)
+        self.end_run()
+
+    def start_run(self):
+        self.cancel_timer()
+        if self.run >= self.runs:
+            self.finish()
+            return
+        if self.last_fix is None:
+            self.get_logger().warning("No gps fix received yet, retrying")
+            self.timer = self.create_timer(self.settle_time, self.start_run)
+            return
+
+        # Goals alternate around the robot so it stays close to the origin
+        heading = self.run * math.pi / 2.0
+        latitude, longitude, _ = enu_to_lat_lon(
+            self.goal_distance * math.cos(heading), self.goal_distance * math.sin(heading),
+            self.last_fix.latitude, self.last_fix.longitude)
+        self.run += 1
+        self.plan_time = None
+        self.goal_time = time.monotonic()
+        self.client.send([latLonYaw2Geopose(float(latitude), float(longitude), heading)],
+                         done_cb=self.run_done_cb)
+        self.timer = self.create_timer(self.run_timeout, self.run_timeout_cb)
+
+    def run_done_cb(self, status, result):
+        # The goal finished before a command was measured
+        self.failed_runs += 1
+        self.get_logger().warning(f"Run {self.run} finished early with status {status}")
+        self.end_run()
+
+    def run_timeout_cb(self):
+        self.failed_runs += 1
+        self.get_logger().warning(f"Run {self.run} timed out")
+        self.end_run()
+
+    def end_run(self):
+        self.goal_time = None
+        self.client.cancel()
+        self.cancel_timer()
+        self.timer = self.create_timer(self.settle_time, self.start_run)
+
+    def cancel_timer(self):
+        if self.timer is not None:
+            self.timer.cancel()
+            self.destroy_timer(self.timer)
+            self.timer = None
+
+    def finish(self):
+        lines = [f"GPS waypoint pipeline latency over {self.runs} runs "
+                 f"({self.failed_runs} failed), in ms",
+                 f"{'stage':<18}{'count':>7}{'mean':>10}{'median':>10}{'p95':>10}{'max':>10}"]
+        for stage, samples in self.samples.items():
+            if not samples:
+                lines.append(f"{stage:<18}{0:>7}")
+                continue
+            ms = np.asarray(samples) * 1e3
+            lines.append(f"{stage:<18}{len(ms):>7}{ms.mean():>10.1f}{np.median(ms):>10.1f}"
+                         f"{np.percentile(ms, 95):>10.1f}{ms.max():>10.1f}")
+        report = "\n".join(lines)
+        self.get_logger().info("\n" + report)
+
+        report_file = os.path.expanduser(self.get_parameter("report_file").value)
+        with open(report_file, 'w') as report_out:
+            report_out.write(report + "\n")
+        self.get_logger().info(f"Report written to {report_file}")
+        self.done.set_result(True)
+
+
+def main():
+    rclpy.init()
+
+    navigator = BasicNavigator("basic_navigator")
+    navigator.waitUntilNav2Active(localizer='robot_localization')
+    navigator.destroy_node()
+
+    benchmark = GpsPipelineBenchmark()
+    benchmark.client.wait_for_server()
+    benchmark.start_run()
+    rclpy.spin_until_future_complete(benchmark, benchmark.done)
+
+
+if __name__ == "__main__":
+    main()
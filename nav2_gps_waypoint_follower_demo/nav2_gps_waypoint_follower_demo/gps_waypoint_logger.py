@@ -7,6 +7,8 @@ import sys
 import tkinter as tk
 from tkinter import messagebox
 from nav2_gps_waypoint_follower_demo.utils.gps_utils import euler_from_quaternion
+from nav2_gps_waypoint_follower_demo.utils.waypoint_log import (
+    WAYPOINT_LOG_EXTENSION, WaypointLogWriter)
 
 
 class GpsGuiLogger(tk.Tk, Node):
@@ -20,6 +22,10 @@ class GpsGuiLogger(tk.Tk, Node):
         self.title("GPS Waypoint Logger")
 
         self.logging_file_path = logging_file_path
+        # Waypoint logs are appended to, yaml files are rewritten on every waypoint
+        self.log_writer = None
+        if logging_file_path.endswith(WAYPOINT_LOG_EXTENSION):
+            self.log_writer = WaypointLogWriter(logging_file_path)
 
         self.gps_pose_label = tk.Label(self, text="Current Coordinates:")
         self.gps_pose_label.pack()
@@ -71,6 +77,18 @@ class GpsGuiLogger(tk.Tk, Node):
         """
         Function to save a new waypoint to a file
         """
+        if self.log_writer is not None:
+            try:
+                self.log_writer.append(self.last_gps_position.latitude,
+                                       self.last_gps_position.longitude,
+                                       self.last_heading)
+            except Exception as ex:
+                messagebox.showerror(
+                    "Error", f"Error logging position: {str(ex)}")
+                return
+            messagebox.showinfo("Info", "Waypoint logged succesfully")
+            return
+
         # read existing waypoints
         try:
             with open(self.logging_file_path, 'r') as yaml_file:
@@ -108,19 +126,23 @@ def main(args=None):
     rclpy.init(args=args)
 
     # allow to pass the logging path as an argument
-    default_yaml_file_path = os.path.expanduser("~/gps_waypoints.yaml")
+    # the waypoint followers read the log as is, compact_waypoint_log turns it into a
+    # yaml file or binary route
+    default_log_file_path = os.path.expanduser("~/gps_waypoints" + WAYPOINT_LOG_EXTENSION)
     if len(sys.argv) > 1:
-        yaml_file_path = sys.argv[1]
+        logging_file_path = sys.argv[1]
     else:
-        yaml_file_path = default_yaml_file_path
+        logging_file_path = default_log_file_path
 
-    gps_gui_logger = GpsGuiLogger(yaml_file_path)
+    gps_gui_logger = GpsGuiLogger(logging_file_path)
 
     while rclpy.ok():
         # we spin both the ROS system and the interface
         rclpy.spin_once(gps_gui_logger, timeout_sec=0.1)  # Run ros2 callbacks
         gps_gui_logger.update()  # Update the tkinter interface
 
+    if gps_gui_logger.log_writer is not None:
+        gps_gui_logger.log_writer.close()
     rclpy.shutdown()
 
 
@@ -1,18 +1,26 @@
 import rclpy
 from rclpy.node import Node
+from action_msgs.msg import GoalStatus
 from nav2_simple_commander.robot_navigator import BasicNavigator
 from geometry_msgs.msg import PointStamped
 from nav2_gps_waypoint_follower_demo.utils.gps_utils import latLonYaw2Geopose
+from nav2_gps_waypoint_follower_demo.utils.gps_waypoint_client import GpsWaypointClient
 
 
 class InteractiveGpsWpCommander(Node):
     """
-    ROS2 node to send gps waypoints to nav2 received from mapviz's point click publisher
+    ROS2 node to send gps waypoints to nav2 received from mapviz's point click publisher.
+    A click preempts the waypoint being followed, or is queued after it when the queue_clicks
+    parameter is set. Callbacks never block: completion is reported from the action callbacks
     """
 
     def __init__(self):
         super().__init__(node_name="gps_wp_commander")
-        self.navigator = BasicNavigator("basic_navigator")
+        self.declare_parameter("queue_clicks", False)
+        self.queue_clicks = self.get_parameter("queue_clicks").value
+
+        self.client = GpsWaypointClient(self)
+        self.queued_wps = []
 
         self.mapviz_wp_sub = self.create_subscription(
             PointStamped, "/clicked_point", self.mapviz_wp_cb, 1)
@@ -26,16 +34,40 @@ class InteractiveGpsWpCommander(Node):
                 "Received point from mapviz that ist not in wgs84 frame. This is not a gps point and wont be followed")
             return
 
-        self.navigator.waitUntilNav2Active(localizer='robot_localization')
-        wp = [latLonYaw2Geopose(msg.point.y, msg.point.x)]
-        self.navigator.followGpsWaypoints(wp)
-        if (self.navigator.isTaskComplete()):
+        wp = latLonYaw2Geopose(msg.point.y, msg.point.x)
+        if self.queue_clicks and self.client.is_active():
+            self.queued_wps.append(wp)
+            self.get_logger().info(f"wp queued, {len(self.queued_wps)} pending")
+            return
+        if self.client.is_active():
+            self.get_logger().info("preempting the current wp")
+        self.send(wp)
+
+    def send(self, wp):
+        self.client.send([wp], done_cb=self.done_cb)
+
+    def done_cb(self, status, result):
+        """
+        Reports the completion of a wp and sends the next queued one
+        """
+        if status == GoalStatus.STATUS_SUCCEEDED:
             self.get_logger().info("wps completed successfully")
+        else:
+            self.get_logger().error(f"wps following failed with status {status}")
+        if self.queued_wps:
+            self.send(self.queued_wps.pop(0))
 
 
 def main():
     rclpy.init()
+
+    # Readiness is only awaited once, not on every click
+    navigator = BasicNavigator("basic_navigator")
+    navigator.waitUntilNav2Active(localizer='robot_localization')
+    navigator.destroy_node()
+
     gps_wpf = InteractiveGpsWpCommander()
+    gps_wpf.client.wait_for_server()
     rclpy.spin(gps_wpf)
 
 
@@ -1,5 +1,6 @@
 import rclpy
 from nav2_simple_commander.robot_navigator import BasicNavigator
+import numpy as np
 import yaml
 from ament_index_python.packages import get_package_share_directory
 import os
@@ -7,6 +8,11 @@ import sys
 import time
 
 from nav2_gps_waypoint_follower_demo.utils.gps_utils import latLonYaw2Geopose
+from nav2_gps_waypoint_follower_demo.utils.route_decimation import DecimatedWaypointParser
+from nav2_gps_waypoint_follower_demo.utils.waypoint_log import (
+    WAYPOINT_LOG_EXTENSION, LogWaypointParser)
+from nav2_gps_waypoint_follower_demo.utils.waypoint_route import (
+    ROUTE_EXTENSION, BinaryWaypointParser)
 
 
 class YamlWaypointParser:
@@ -18,25 +24,56 @@ class YamlWaypointParser:
         with open(wps_file_path, 'r') as wps_file:
             self.wps_dict = yaml.safe_load(wps_file)
 
-    def get_wps(self):
+    def __len__(self):
+        return len(self.wps_dict["waypoints"])
+
+    def get_arrays(self):
+        """
+        Latitudes, longitudes and yaws of all waypoints
         """
-        Get an array of geographic_msgs/msg/GeoPose objects from the yaml file
+        wps = self.wps_dict["waypoints"]
+        return (np.array([wp["latitude"] for wp in wps], dtype=np.float64),
+                np.array([wp["longitude"] for wp in wps], dtype=np.float64),
+                np.array([wp["yaw"] for wp in wps], dtype=np.float64))
+
+    def get_wps(self, start: int = 0, count: int = None):
+        """
+        Get an array of geographic_msgs/msg/GeoPose objects from the yaml file,
+        optionally only for waypoints [start, start + count)
         """
         gepose_wps = []
-        for wp in self.wps_dict["waypoints"]:
+        for wp in self.wps_dict["waypoints"][start:None if count is None else start + count]:
             latitude, longitude, yaw = wp["latitude"], wp["longitude"], wp["yaw"]
             gepose_wps.append(latLonYaw2Geopose(latitude, longitude, yaw))
         return gepose_wps
 
 
+def make_waypoint_parser(wps_file_path: str, max_cross_track_error: float = 0.0,
+                         max_yaw_change: float = 0.5):
+    """
+    Parser of a yaml, binary route or waypoint log file, decimated if
+    max_cross_track_error > 0
+    """
+    # Binary routes (see waypoints_to_route) are mapped instead of parsed
+    if wps_file_path.endswith(ROUTE_EXTENSION):
+        wp_parser = BinaryWaypointParser(wps_file_path)
+    elif wps_file_path.endswith(WAYPOINT_LOG_EXTENSION):
+        wp_parser = LogWaypointParser(wps_file_path)
+    else:
+        wp_parser = YamlWaypointParser(wps_file_path)
+    if max_cross_track_error > 0.0:
+        wp_parser = DecimatedWaypointParser(wp_parser, max_cross_track_error, max_yaw_change)
+    return wp_parser
+
+
 class GpsWpCommander():
     """
     Class to use nav2 gps waypoint follower to follow a set of waypoints logged in a yaml file
     """
 
-    def __init__(self, wps_file_path):
+    def __init__(self, wps_file_path, max_cross_track_error=0.0):
         self.navigator = BasicNavigator("basic_navigator")
-        self.wp_parser = YamlWaypointParser(wps_file_path)
+        self.wp_parser = make_waypoint_parser(wps_file_path, max_cross_track_error)
 
     def start_wpf(self):
         """
@@ -61,7 +98,10 @@ def main():
     else:
         yaml_file_path = default_yaml_file_path
 
-    gps_wpf = GpsWpCommander(yaml_file_path)
+    # optional maximum cross-track error (m) to decimate the waypoints with
+    max_cross_track_error = float(sys.argv[2]) if len(sys.argv) > 2 else 0.0
+
+    gps_wpf = GpsWpCommander(yaml_file_path, max_cross_track_error)
     gps_wpf.start_wpf()
 
 
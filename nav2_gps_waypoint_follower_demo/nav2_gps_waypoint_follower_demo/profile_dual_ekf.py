@@ -0,0 +1,58 @@
+import os
+import subprocess
+import sys
+import tempfile
+
+import yaml
+
+
+def main():
+    """
+    Replays a bag into the dual EKF setup once per combination of filter frequency and
+    sensor queue size (dual_ekf_profile.launch.py), then prints the profiles side by side
+    """
+    if len(sys.argv) < 4:
+        print("Usage: profile_dual_ekf <bag> <frequencies> <queue_sizes> [rate]\n"
+              "  e.g. profile_dual_ekf gps_run 10,20,30 1,10 2.0")
+        sys.exit(1)
+
+    bag = os.path.abspath(sys.argv[1])
+    frequencies = [float(f) for f in sys.argv[2].split(",")]
+    queue_sizes = [int(q) for q in sys.argv[3].split(",")]
+    rate = sys.argv[4] if len(sys.argv) > 4 else "1.0"
+
+    reports = []
+    with tempfile.TemporaryDirectory() as report_dir:
+        for frequency in frequencies:
+            for queue_size in queue_sizes:
+                report_file = os.path.join(report_dir, f"{frequency}_{queue_size}.yaml")
+                print(f"Profiling frequency {frequency} queue_size {queue_size}", flush=True)
+                subprocess.run(
+                    ["ros2", "launch", "nav2_gps_waypoint_follower_demo",
+                     "dual_ekf_profile.launch.py", f"bag:={bag}", f"rate:={rate}",
+                     f"frequency:={frequency}", f"queue_size:={queue_size}",
+                     f"report_file:={report_file}"],
+                    stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+                if not os.path.exists(report_file):
+                    print("  no profile written, is the bag readable?")
+                    continue
+                with open(report_file, 'r') as report_in:
+                    reports.append(yaml.safe_load(report_in))
+
+    print(f"{'filter':<22}{'freq':>6}{'queue':>6}{'updates':>9}{'cpu/upd ms':>12}"
+          f"{'load %':>8}{'jitter ms':>11}{'p99 ms':>9}{'gps rms m':>11}")
+    for report in reports:
+        rms = report["gps_rms_error_m"]
+        for name, stats in report["filters"].items():
+            row = f"{name:<22}{report['frequency']:>6.1f}{report['queue_size']:>6}"
+            if stats["updates"] == 0:
+                print(row + f"{0:>9}")
+                continue
+            print(row + f"{stats['updates']:>9}{stats['cpu_per_update_ms']:>12.3f}"
+                  f"{stats['cpu_load'] * 100.0:>8.1f}{stats['jitter_std_ms']:>11.2f}"
+                  f"{stats['jitter_p99_ms']:>9.2f}"
+                  f"{'-' if rms is None else format(rms, '.3f'):>11}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,170 @@
+import numpy as np
+import rclpy
+from rclpy.node import Node
+from rclpy.task import Future
+from action_msgs.msg import GoalStatus
+from geographic_msgs.msg import GeoPoint
+from robot_localization.srv import FromLL
+from nav2_simple_commander.robot_navigator import BasicNavigator
+from ament_index_python.packages import get_package_share_directory
+import os
+import sys
+
+from nav2_gps_waypoint_follower_demo.logged_waypoint_follower import make_waypoint_parser
+from nav2_gps_waypoint_follower_demo.utils.geofence import (
+    KeepoutIndex, MapFrameConverter, find_keepout_waypoints)
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import enu_to_lat_lon
+from nav2_gps_waypoint_follower_demo.utils.gps_waypoint_client import (
+    GpsWaypointClient, missed_waypoint_indices)
+from nav2_gps_waypoint_follower_demo.utils.waypoint_route import WaypointSubsetParser
+
+
+class StreamingGpsWpCommander(Node):
+    """
+    Follows a logged set of gps waypoints keeping only a sliding window of them queued in the
+    waypoint follower. When the robot is halfway through the window, a goal with the next
+    window is sent, preempting the running one, so goal size does not depend on route length
+    """
+
+    def __init__(self, wps_file_path):
+        super().__init__(node_name="streaming_gps_wp_commander")
+        self.declare_parameter("window_size", 20)
+        self.window_size = max(2, self.get_parameter("window_size").value)
+        # Decimation of the route, disabled with 0.0
+        self.declare_parameter("max_cross_track_error", 0.0)
+        self.declare_parameter("max_yaw_change", 0.5)
+
+        self.wp_parser = make_waypoint_parser(
+            wps_file_path, self.get_parameter("max_cross_track_error").value,
+            self.get_parameter("max_yaw_change").value)
+        # Route validation against a keepout filter mask, disabled with an empty path.
+        # Waypoints within keepout_clearance meters of a keepout cell either abort the
+        # route or are skipped with skip_keepout_wps
+        self.declare_parameter("keepout_mask_yaml", "")
+        self.declare_parameter("keepout_clearance", 0.0)
+        self.declare_parameter("skip_keepout_wps", False)
+
+        self.client = GpsWaypointClient(self)
+        self.done = Future()
+        # Route index of the first waypoint of the current window
+        self.window_start = 0
+        # Last waypoint of the current window reported by the feedback
+        self.window_wp = 0
+        self.missed_wps = set()
+
+    def start_wpf(self):
+        """
+        Sends the first window, the following ones are sent from the feedback callbacks
+        """
+        self.client.wait_for_server()
+        if not self.validate_route():
+            self.done.set_result(GoalStatus.STATUS_ABORTED)
+            return
+        self.get_logger().info(
+            f"Following {len(self.wp_parser)} wps in windows of {self.window_size}")
+        self.send_window(0)
+
+    def from_ll(self, client, latitude, longitude):
+        request = FromLL.Request()
+        request.ll_point = GeoPoint(latitude=float(latitude), longitude=float(longitude))
+        future = client.call_async(request)
+        rclpy.spin_until_future_complete(self, future)
+        return future.result().map_point.x, future.result().map_point.y
+
+    def validate_route(self):
+        """
+        Checks all the route against the keepout mask before anything is sent. The map
+        frame is calibrated from the navsat_transform positions of the first waypoint and
+        of a point 100 m east of it, then the route is converted in one batch
+        """
+        mask_yaml = self.get_parameter("keepout_mask_yaml").value
+        if not mask_yaml or len(self.wp_parser) == 0:
+            return True
+        keepout_index = KeepoutIndex(mask_yaml)
+
+        latitudes, longitudes, yaws = self.wp_parser.get_arrays()
+        east_latitude, east_longitude, _ = enu_to_lat_lon(100.0, 0.0, latitudes[0], longitudes[0])
+        from_ll_client = self.create_client(FromLL, "fromLL")
+        from_ll_client.wait_for_service()
+        reference_lat_lons = [(latitudes[0], longitudes[0]), (east_latitude, east_longitude)]
+        converter = MapFrameConverter(
+            reference_lat_lons, [self.from_ll(from_ll_client, *ll) for ll in reference_lat_lons])
+        self.destroy_client(from_ll_client)
+
+        rejected = find_keepout_waypoints(keepout_index, converter, latitudes, longitudes,
+                                          self.get_parameter("keepout_clearance").value)
+        if len(rejected) == 0:
+            return True
+        if not self.get_parameter("skip_keepout_wps").value:
+            self.get_logger().error(f"Route rejected, wps in keepout zones: {rejected.tolist()}")
+            return False
+        self.get_logger().warning(f"Skipping wps in keepout zones: {rejected.tolist()}")
+        keep = np.ones(len(self.wp_parser), dtype=bool)
+        keep[rejected] = False
+        self.wp_parser = WaypointSubsetParser(self.wp_parser, np.flatnonzero(keep))
+        return True
+
+    def send_window(self, start):
+        self.window_start = start
+        self.window_wp = 0
+        self.client.send(self.wp_parser.get_wps(start, self.window_size),
+                         feedback_cb=self.feedback_cb, done_cb=self.done_cb)
+
+    def feedback_cb(self, current_waypoint):
+        """
+        Slides the window once the robot is halfway through it, if waypoints remain.
+        The follower drops the result of a preempted goal, so its missed waypoints are
+        tracked here: waypoints the feedback jumped over were skipped
+        """
+        self.missed_wps.update(
+            range(self.window_start + self.window_wp + 1, self.window_start + current_waypoint))
+        self.window_wp = max(self.window_wp, current_waypoint)
+        window_end = self.window_start + self.window_size
+        if current_waypoint >= self.window_size // 2 and window_end < len(self.wp_parser):
+            self.send_window(self.window_start + current_waypoint)
+
+    def done_cb(self, status, result):
+        """
+        The result lists the missed waypoints of the last window. A waypoint the follower
+        failed at in an earlier window is only reported if the feedback jumped over it:
+        it moves on to the next one like after a reached waypoint
+        """
+        self.missed_wps.update(self.window_start + i for i in missed_waypoint_indices(result))
+        window_end = self.window_start + self.window_size
+        if status == GoalStatus.STATUS_SUCCEEDED and window_end < len(self.wp_parser):
+            # Window completed before the feedback slid it, e.g. very short windows
+            self.send_window(window_end)
+            return
+
+        if status == GoalStatus.STATUS_SUCCEEDED:
+            self.get_logger().info("wps completed successfully")
+        else:
+            self.get_logger().error(f"wps following failed with status {status}")
+        if self.missed_wps:
+            self.get_logger().warning(f"Missed wps: {sorted(self.missed_wps)}")
+        self.done.set_result(status)
+
+
+def main():
+    rclpy.init()
+
+    # allow to pass the waypoints file as an argument
+    default_yaml_file_path = os.path.join(get_package_share_directory(
+        "nav2_gps_waypoint_follower_demo"), "config", "demo_waypoints.yaml")
+    if len(sys.argv) > 1 and not sys.argv[1].startswith("--"):
+        wps_file_path = sys.argv[1]
+    else:
+        wps_file_path = default_yaml_file_path
+
+    # Readiness is only awaited once, before streaming starts
+    navigator = BasicNavigator("basic_navigator")
+    navigator.waitUntilNav2Active(localizer='robot_localization')
+    navigator.destroy_node()
+
+    gps_wpf = StreamingGpsWpCommander(wps_file_path)
+    gps_wpf.start_wpf()
+    rclpy.spin_until_future_complete(gps_wpf, gps_wpf.done)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,128 @@
+import math
+import os
+
+import numpy as np
+import yaml
+
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import lat_lon_to_utm
+
+
+def load_mask(mask_yaml_path: str):
+    """
+    Loads a filter mask (map_server yaml + binary PGM) as an OccupancyGrid-like int8 array,
+    row 0 at the bottom, using the same trinary/scale/raw conversion as map_server.
+    Returns values, resolution, origin_x, origin_y
+    """
+    with open(mask_yaml_path, 'r') as mask_file:
+        params = yaml.safe_load(mask_file)
+    image_path = params["image"]
+    if not os.path.isabs(image_path):
+        image_path = os.path.join(os.path.dirname(mask_yaml_path), image_path)
+
+    with open(image_path, "rb") as image_file:
+        data = image_file.read()
+    # P5 header: magic, width, height, maxval, skipping comments
+    fields, pos = [], 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[pos:end])
+        pos = end
+    if fields[0] != b"P5" or int(fields[3]) > 255:
+        raise ValueError(f"{image_path} is not an 8 bit binary PGM")
+    width, height, max_value = int(fields[1]), int(fields[2]), int(fields[3])
+    pixels = np.frombuffer(data, dtype=np.uint8, count=width * height, offset=pos + 1)
+
+    # Lookup table of the 256 pixel values
+    shade = np.arange(256) / max_value
+    occ = shade if params.get("negate", 0) else 1.0 - shade
+    occupied, free = params["occupied_thresh"], params["free_thresh"]
+    mode = params.get("mode", "trinary")
+    lut = np.full(256, -1, dtype=np.int8)
+    if mode == "raw":
+        raw = np.round(shade * 255)
+        lut[raw <= 100] = raw[raw <= 100]
+    else:
+        if mode == "scale":
+            scaled = np.rint((occ - free) / (occupied - free) * 100.0)
+            lut = np.where((occ >= free) & (occ <= occupied), scaled, lut).astype(np.int8)
+        lut[occ > occupied] = 100
+        lut[occ < free] = 0
+    lut[np.arange(256) > max_value] = -1
+
+    values = lut[pixels].reshape(height, width)[::-1]
+    origin = params["origin"]
+    return values, float(params["resolution"]), float(origin[0]), float(origin[1])
+
+
+class KeepoutIndex:
+    """
+    Keepout cells of a filter mask with a summed area table over them, so whether a square
+    of any size holds a keepout cell is answered with four lookups, whatever its size
+    """
+
+    def __init__(self, mask_yaml_path: str, keepout_threshold: int = 100):
+        values, self.resolution, self.origin_x, self.origin_y = load_mask(mask_yaml_path)
+        self.height, self.width = values.shape
+        keepout = (values >= keepout_threshold).astype(np.int32)
+        # sat[j, i] = keepout cells in rows < j and columns < i
+        self.sat = np.zeros((self.height + 1, self.width + 1), dtype=np.int32)
+        self.sat[1:, 1:] = keepout.cumsum(axis=0).cumsum(axis=1)
+
+    def in_keepout(self, x, y, clearance: float = 0.0):
+        """
+        For arrays of map frame positions, whether a keepout cell lies within clearance
+        meters (square neighbourhood). Positions outside the mask are not in keepout
+        """
+        x = np.asarray(x, dtype=np.float64)
+        y = np.asarray(y, dtype=np.float64)
+        min_i = np.floor((x - clearance - self.origin_x) / self.resolution).astype(np.int64)
+        min_j = np.floor((y - clearance - self.origin_y) / self.resolution).astype(np.int64)
+        max_i = np.floor((x + clearance - self.origin_x) / self.resolution).astype(np.int64)
+        max_j = np.floor((y + clearance - self.origin_y) / self.resolution).astype(np.int64)
+
+        # Half-open cell ranges clamped to the mask
+        i0 = np.clip(min_i, 0, self.width)
+        j0 = np.clip(min_j, 0, self.height)
+        i1 = np.clip(max_i + 1, 0, self.width)
+        j1 = np.clip(max_j + 1, 0, self.height)
+        count = self.sat[j1, i1] - self.sat[j0, i1] - self.sat[j1, i0] + self.sat[j0, i0]
+        return count > 0
+
+
+class MapFrameConverter:
+    """
+    Batch conversion of latitudes/longitudes to the map frame of navsat_transform. The map
+    frame is a rigid transform of the UTM grid, calibrated from the map positions of two
+    reference points (e.g. obtained from navsat_transform's fromLL service)
+    """
+
+    def __init__(self, reference_lat_lons, reference_map_points):
+        (lat0, lon0), (lat1, lon1) = reference_lat_lons
+        (mx0, my0), (mx1, my1) = reference_map_points
+        e, n, self.zone, self.north = lat_lon_to_utm([lat0, lat1], [lon0, lon1])
+        yaw = math.atan2(my1 - my0, mx1 - mx0) - math.atan2(n[1] - n[0], e[1] - e[0])
+        self.cos_yaw, self.sin_yaw = math.cos(yaw), math.sin(yaw)
+        self.utm0 = (e[0], n[0])
+        self.map0 = (mx0, my0)
+
+    def to_map(self, latitudes, longitudes):
+        e, n, _, _ = lat_lon_to_utm(latitudes, longitudes, self.zone, self.north)
+        de, dn = e - self.utm0[0], n - self.utm0[1]
+        return (self.map0[0] + self.cos_yaw * de - self.sin_yaw * dn,
+                self.map0[1] + self.sin_yaw * de + self.cos_yaw * dn)
+
+
+def find_keepout_waypoints(keepout_index: KeepoutIndex, converter: MapFrameConverter,
+                           latitudes, longitudes, clearance: float = 0.0):
+    """
+    Indices of the waypoints within clearance meters of a keepout cell
+    """
+    x, y = converter.to_map(latitudes, longitudes)
+    return np.flatnonzero(keepout_index.in_keepout(x, y, clearance))
@@ -1,4 +1,5 @@
 import math
+import numpy as np
 from geographic_msgs.msg import GeoPose
 from geometry_msgs.msg import Quaternion
 
@@ -52,3 +53,196 @@ def latLonYaw2Geopose(latitude: float, longitude: float, yaw: float = 0.0) -> Ge
     geopose.position.longitude = longitude
     geopose.orientation = quaternion_from_euler(0.0, 0.0, yaw)
     return geopose
+
+
+# Batch conversions over numpy arrays, mirroring nav2_gps_route_recorder/geodesy.hpp
+# so whole survey routes are converted without a per-point Python loop
+
+WGS84_A = 6378137.0
+WGS84_F = 1.0 / 298.257223563
+WGS84_E2 = WGS84_F * (2.0 - WGS84_F)
+
+UTM_K0 = 0.9996
+UTM_FALSE_EASTING = 500000.0
+UTM_FALSE_NORTHING_SOUTH = 10000000.0
+
+
+def _utm_constants():
+    """
+    4th order Krueger series coefficients of the WGS84 transverse mercator projection
+    """
+    n = WGS84_F / (2.0 - WGS84_F)
+    n2, n3, n4 = n * n, n ** 3, n ** 4
+    scale = UTM_K0 * WGS84_A / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0)
+    alpha = (n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0,
+             13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0,
+             61.0 * n3 / 240.0 - 103.0 * n4 / 140.0,
+             49561.0 * n4 / 161280.0)
+    beta = (n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0,
+            n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0,
+            17.0 * n3 / 480.0 - 37.0 * n4 / 840.0,
+            4397.0 * n4 / 161280.0)
+    delta = (2.0 * n - 2.0 * n2 / 3.0 - 2.0 * n3 + 116.0 * n4 / 45.0,
+             7.0 * n2 / 3.0 - 8.0 * n3 / 5.0 - 227.0 * n4 / 45.0,
+             56.0 * n3 / 15.0 - 136.0 * n4 / 35.0,
+             4279.0 * n4 / 630.0)
+    return scale, 2.0 * math.sqrt(n) / (1.0 + n), alpha, beta, delta
+
+
+_UTM_SCALE, _UTM_CONFORMAL, _UTM_ALPHA, _UTM_BETA, _UTM_DELTA = _utm_constants()
+
+
+def utm_zone(latitude: float, longitude: float) -> int:
+    """
+    UTM zone of a point, with the Norway and Svalbard exceptions
+    """
+    lon = longitude - 360.0 * math.floor((longitude + 180.0) / 360.0)
+    if 56.0 <= latitude < 64.0 and 3.0 <= lon < 12.0:
+        return 32
+    if 72.0 <= latitude < 84.0 and 0.0 <= lon < 42.0:
+        return 31 if lon < 9.0 else 33 if lon < 21.0 else 35 if lon < 33.0 else 37
+    return min(int(math.floor((lon + 180.0) / 6.0)) + 1, 60)
+
+
+def lat_lon_to_utm(latitudes, longitudes, zone: int = None, north: bool = None):
+    """
+    Converts arrays of latitudes and longitudes (degrees) to UTM eastings and northings.
+    All points are projected in the same zone, the one of the first point by default.
+    Returns eastings, northings, zone, north
+    """
+    lat = np.radians(np.asarray(latitudes, dtype=np.float64))
+    lon = np.radians(np.asarray(longitudes, dtype=np.float64))
+    if zone is None:
+        zone = utm_zone(math.degrees(lat.flat[0]), math.degrees(lon.flat[0]))
+    if north is None:
+        north = bool(lat.flat[0] >= 0.0)
+
+    dlon = lon - math.radians(zone * 6.0 - 183.0)
+    sin_lat = np.sin(lat)
+    t = np.sinh(np.arctanh(sin_lat) - _UTM_CONFORMAL * np.arctanh(_UTM_CONFORMAL * sin_lat))
+    xi = np.arctan2(t, np.cos(dlon))
+    eta = np.arctanh(np.sin(dlon) / np.sqrt(1.0 + t * t))
+
+    x = eta.copy()
+    y = xi.copy()
+    for j, a in enumerate(_UTM_ALPHA, start=1):
+        x += a * np.cos(2 * j * xi) * np.sinh(2 * j * eta)
+        y += a * np.sin(2 * j * xi) * np.cosh(2 * j * eta)
+
+    eastings = UTM_FALSE_EASTING + _UTM_SCALE * x
+    northings = (0.0 if north else UTM_FALSE_NORTHING_SOUTH) + _UTM_SCALE * y
+    return eastings, northings, zone, north
+
+
+def utm_to_lat_lon(eastings, northings, zone: int, north: bool = True):
+    """
+    Converts arrays of UTM eastings and northings of a zone to latitudes and longitudes (degrees)
+    """
+    false_northing = 0.0 if north else UTM_FALSE_NORTHING_SOUTH
+    xi = (np.asarray(northings, dtype=np.float64) - false_northing) / _UTM_SCALE
+    eta = (np.asarray(eastings, dtype=np.float64) - UTM_FALSE_EASTING) / _UTM_SCALE
+
+    xi_p = xi.copy()
+    eta_p = eta.copy()
+    for j, b in enumerate(_UTM_BETA, start=1):
+        xi_p -= b * np.sin(2 * j * xi) * np.cosh(2 * j * eta)
+        eta_p -= b * np.cos(2 * j * xi) * np.sinh(2 * j * eta)
+
+    chi = np.arcsin(np.sin(xi_p) / np.cosh(eta_p))
+    lat = chi.copy()
+    for j, d in enumerate(_UTM_DELTA, start=1):
+        lat += d * np.sin(2 * j * chi)
+    lon = math.radians(zone * 6.0 - 183.0) + np.arctan2(np.sinh(eta_p), np.cos(xi_p))
+    return np.degrees(lat), np.degrees(lon)
+
+
+def _to_ecef(lat, lon, alt):
+    sin_lat = np.sin(lat)
+    cos_lat = np.cos(lat)
+    n = WGS84_A / np.sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat)
+    return ((n + alt) * cos_lat * np.cos(lon),
+            (n + alt) * cos_lat * np.sin(lon),
+            (n * (1.0 - WGS84_E2) + alt) * sin_lat)
+
+
+def lat_lon_to_enu(latitudes, longitudes, origin_latitude: float, origin_longitude: float,
+                   altitudes=0.0, origin_altitude: float = 0.0):
+    """
+    Converts arrays of latitudes and longitudes (degrees) to the East-North-Up frame
+    tangent to the ellipsoid at the origin. Returns east, north, up
+    """
+    lat0 = math.radians(origin_latitude)
+    lon0 = math.radians(origin_longitude)
+    x0, y0, z0 = _to_ecef(lat0, lon0, origin_altitude)
+    x, y, z = _to_ecef(np.radians(np.asarray(latitudes, dtype=np.float64)),
+                       np.radians(np.asarray(longitudes, dtype=np.float64)),
+                       np.asarray(altitudes, dtype=np.float64))
+    x, y, z = x - x0, y - y0, z - z0
+    t = math.cos(lon0) * x + math.sin(lon0) * y
+    east = -math.sin(lon0) * x + math.cos(lon0) * y
+    north = -math.sin(lat0) * t + math.cos(lat0) * z
+    up = math.cos(lat0) * t + math.sin(lat0) * z
+    return east, north, up
+
+
+def enu_to_lat_lon(east, north, origin_latitude: float, origin_longitude: float,
+                   up=0.0, origin_altitude: float = 0.0):
+    """
+    Converts arrays of East-North-Up coordinates around the origin back to latitudes,
+    longitudes (degrees) and altitudes
+    """
+    lat0 = math.radians(origin_latitude)
+    lon0 = math.radians(origin_longitude)
+    x0, y0, z0 = _to_ecef(lat0, lon0, origin_altitude)
+    east = np.asarray(east, dtype=np.float64)
+    north = np.asarray(north, dtype=np.float64)
+    up = np.asarray(up, dtype=np.float64)
+    t = -math.sin(lat0) * north + math.cos(lat0) * up
+    x = x0 - math.sin(lon0) * east + math.cos(lon0) * t
+    y = y0 + math.cos(lon0) * east + math.sin(lon0) * t
+    z = z0 + math.cos(lat0) * north + math.sin(lat0) * up
+
+    # Fixed point iteration on the latitude, as in geodesy.hpp
+    p = np.hypot(x, y)
+    lat = np.arctan2(z, p * (1.0 - WGS84_E2))
+    alt = np.zeros_like(lat)
+    for _ in range(4):
+        sin_lat = np.sin(lat)
+        n = WGS84_A / np.sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat)
+        alt = p / np.cos(lat) - n
+        lat = np.arctan2(z, p * (1.0 - WGS84_E2 * n / (n + alt)))
+    return np.degrees(lat), np.degrees(np.arctan2(y, x)), alt
+
+
+def yaws_to_quaternions(yaws):
+    """
+    Converts an array of yaws to the z and w components of planar quaternions
+    """
+    half = 0.5 * np.asarray(yaws, dtype=np.float64)
+    return np.sin(half), np.cos(half)
+
+
+def yaws_from_quaternions(qx, qy, qz, qw):
+    """
+    Yaw of arrays of quaternion components
+    """
+    qx, qy, qz, qw = (np.asarray(q, dtype=np.float64) for q in (qx, qy, qz, qw))
+    return np.arctan2(2.0 * (qw * qz + qx * qy), 1.0 - 2.0 * (qy * qy + qz * qz))
+
+
+def latLonYaw2Geoposes(latitudes, longitudes, yaws=None) -> list:
+    """
+    Creates geographic_msgs/msg/GeoPose objects from arrays of latitudes, longitudes and yaws
+    """
+    latitudes = np.asarray(latitudes, dtype=np.float64)
+    longitudes = np.asarray(longitudes, dtype=np.float64)
+    qz, qw = yaws_to_quaternions(np.zeros_like(latitudes) if yaws is None else yaws)
+    geoposes = []
+    for lat, lon, z, w in zip(latitudes.tolist(), longitudes.tolist(), qz.tolist(), qw.tolist()):
+        geopose = GeoPose()
+        geopose.position.latitude = lat
+        geopose.position.longitude = lon
+        geopose.orientation.z = z
+        geopose.orientation.w = w
+        geoposes.append(geopose)
+    return geoposes
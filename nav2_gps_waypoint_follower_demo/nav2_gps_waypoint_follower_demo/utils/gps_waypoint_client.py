@@ -0,0 +1,94 @@
+from action_msgs.msg import GoalStatus
+from nav2_msgs.action import FollowGPSWaypoints
+from rclpy.action import ActionClient
+from rclpy.node import Node
+
+
+class GpsWaypointClient:
+    """
+    Non blocking client of the nav2 gps waypoint follower. Goals are sent asynchronously and
+    a new goal preempts the running one; feedback and results of preempted goals are dropped,
+    so the callbacks always refer to the last goal sent
+    """
+
+    def __init__(self, node: Node, action_name: str = "follow_gps_waypoints"):
+        self.node = node
+        self.action_client = ActionClient(node, FollowGPSWaypoints, action_name)
+        self.goal_handle = None
+        self.goal_id = 0
+        self.feedback_cb = None
+        self.done_cb = None
+
+    def wait_for_server(self, timeout_sec: float = None) -> bool:
+        return self.action_client.wait_for_server(timeout_sec=timeout_sec)
+
+    def is_active(self) -> bool:
+        return self.done_cb is not None
+
+    def send(self, wps, feedback_cb=None, done_cb=None):
+        """
+        Sends a list of geographic_msgs/msg/GeoPose, preempting the running goal.
+        feedback_cb(current_waypoint) is called on every feedback of this goal and
+        done_cb(status, result) once it finishes (result is None if rejected)
+        """
+        self.goal_id += 1
+        goal_id = self.goal_id
+        self.goal_handle = None
+        self.feedback_cb = feedback_cb
+        self.done_cb = done_cb
+
+        goal = FollowGPSWaypoints.Goal()
+        goal.gps_poses = wps
+        future = self.action_client.send_goal_async(
+            goal, feedback_callback=lambda msg: self._feedback(goal_id, msg))
+        future.add_done_callback(lambda f: self._goal_response(goal_id, f))
+
+    def cancel(self):
+        """
+        Cancels the running goal, its done callback is not called
+        """
+        self.goal_id += 1
+        self.feedback_cb = None
+        self.done_cb = None
+        if self.goal_handle is not None:
+            self.goal_handle.cancel_goal_async()
+            self.goal_handle = None
+
+    def _goal_response(self, goal_id, future):
+        goal_handle = future.result()
+        if goal_id != self.goal_id:
+            return
+        if not goal_handle.accepted:
+            self._finish(GoalStatus.STATUS_ABORTED, None)
+            return
+        self.goal_handle = goal_handle
+        goal_handle.get_result_async().add_done_callback(
+            lambda f: self._result(goal_id, f))
+
+    def _feedback(self, goal_id, msg):
+        if goal_id == self.goal_id and self.feedback_cb is not None:
+            self.feedback_cb(msg.feedback.current_waypoint)
+
+    def _result(self, goal_id, future):
+        if goal_id != self.goal_id:
+            return
+        response = future.result()
+        self.goal_handle = None
+        self._finish(response.status, response.result)
+
+    def _finish(self, status, result):
+        done_cb = self.done_cb
+        self.feedback_cb = None
+        self.done_cb = None
+        if done_cb is not None:
+            done_cb(status, result)
+
+
+def missed_waypoint_indices(result) -> list:
+    """
+    Indices of the missed waypoints of a FollowGPSWaypoints result, across nav2 versions
+    (plain indices in humble, MissedWaypoint messages afterwards)
+    """
+    if result is None:
+        return []
+    return [getattr(wp, "index", wp) for wp in result.missed_waypoints]
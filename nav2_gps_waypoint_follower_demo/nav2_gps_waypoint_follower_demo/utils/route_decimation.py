@@ -0,0 +1,69 @@
+import math
+
+import numpy as np
+
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import lat_lon_to_enu
+from nav2_gps_waypoint_follower_demo.utils.waypoint_route import WaypointSubsetParser
+
+
+def decimate_route(latitudes, longitudes, yaws=None, max_cross_track_error: float = 0.5,
+                   max_yaw_change: float = 0.5):
+    """
+    Douglas-Peucker decimation of a route in the ENU frame of its first waypoint, same
+    algorithm as route_decimation.hpp of nav2_gps_route_recorder.
+    Waypoints are dropped while the path through the kept ones stays within
+    max_cross_track_error meters of them; both ends of every heading change larger than
+    max_yaw_change radians are kept. Returns the sorted indices of the kept waypoints.
+    Costs O(n log n) when splits fall near the middle of their range, O(n^2) in the
+    worst case of splits peeling one waypoint at a time (e.g. a spiral), bounded by the
+    longest run of waypoints between two heading changes
+    """
+    latitudes = np.asarray(latitudes, dtype=np.float64)
+    count = len(latitudes)
+    if count < 3:
+        return np.arange(count)
+    x, y, _ = lat_lon_to_enu(latitudes, longitudes, latitudes[0], longitudes[0])
+
+    keep = np.zeros(count, dtype=bool)
+    keep[0] = keep[-1] = True
+    if yaws is not None:
+        yaws = np.asarray(yaws, dtype=np.float64).tolist()
+        anchor = yaws[0]
+        for i in range(1, count):
+            if abs(math.remainder(yaws[i] - anchor, 2.0 * math.pi)) > max_yaw_change:
+                keep[i - 1] = keep[i] = True
+                anchor = yaws[i]
+
+    max_error_sq = max_cross_track_error * max_cross_track_error
+    stack = []
+    splits = np.flatnonzero(keep)
+    for first, last in zip(splits[:-1], splits[1:]):
+        stack.append((first, last))
+        while stack:
+            first, last = stack.pop()
+            if last - first < 2:
+                continue
+            # Squared distances of the inner waypoints to the segment
+            dx, dy = x[last] - x[first], y[last] - y[first]
+            px, py = x[first + 1:last] - x[first], y[first + 1:last] - y[first]
+            length_sq = dx * dx + dy * dy
+            t = np.clip((px * dx + py * dy) / length_sq, 0.0, 1.0) if length_sq > 0.0 else 0.0
+            dist_sq = (t * dx - px) ** 2 + (t * dy - py) ** 2
+            worst = int(np.argmax(dist_sq))
+            if dist_sq[worst] > max_error_sq:
+                worst += first + 1
+                keep[worst] = True
+                stack.append((first, worst))
+                stack.append((worst, last))
+    return np.flatnonzero(keep)
+
+
+class DecimatedWaypointParser(WaypointSubsetParser):
+    """
+    Exposes the waypoints of another parser kept by decimate_route()
+    """
+
+    def __init__(self, wp_parser, max_cross_track_error: float, max_yaw_change: float = 0.5):
+        latitudes, longitudes, yaws = wp_parser.get_arrays()
+        super().__init__(wp_parser, decimate_route(latitudes, longitudes, yaws,
+                                                   max_cross_track_error, max_yaw_change))
@@ -0,0 +1,105 @@
+import os
+import struct
+import time
+import zlib
+
+import numpy as np
+
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import latLonYaw2Geoposes
+
+# Append-only waypoint log: a sequence of fixed size little endian records
+#   magic (4 bytes), latitude, longitude, yaw (doubles), crc32 of the three doubles
+# Every record is written with a single append, so a crash can at worst leave a torn
+# last record, which writers truncate before appending again. Corrupted records are
+# skipped by readers
+WAYPOINT_LOG_EXTENSION = ".wplog"
+RECORD_MAGIC = b"WPT1"
+RECORD = struct.Struct("<4s3dI")
+RECORD_DTYPE = np.dtype([("magic", "S4"), ("latitude", "<f8"), ("longitude", "<f8"),
+                         ("yaw", "<f8"), ("crc", "<u4")])
+
+
+def read_waypoint_log(log_file_path: str):
+    """
+    Reads the valid records of a waypoint log, skipping torn or corrupted ones.
+    Returns latitudes, longitudes and yaws arrays
+    """
+    data = np.fromfile(log_file_path, dtype=np.uint8)
+    records = data[:len(data) - len(data) % RECORD.size].view(RECORD_DTYPE)
+    # Raw bytes of the three doubles of every record
+    payloads = data[:records.nbytes].reshape(-1, RECORD.size)[:, 4:28]
+    valid = np.array([zlib.crc32(payload.tobytes()) == int(crc)
+                      for payload, crc in zip(payloads, records["crc"])], dtype=bool)
+    records = records[valid & (records["magic"] == RECORD_MAGIC)]
+    return records["latitude"].copy(), records["longitude"].copy(), records["yaw"].copy()
+
+
+class LogWaypointParser:
+    """
+    Parse the valid waypoints of a waypoint log, as it was when the parser was created
+    """
+
+    def __init__(self, wps_file_path: str) -> None:
+        self.latitudes, self.longitudes, self.yaws = read_waypoint_log(wps_file_path)
+
+    def __len__(self):
+        return len(self.latitudes)
+
+    def get_arrays(self):
+        return self.latitudes, self.longitudes, self.yaws
+
+    def get_wps(self, start: int = 0, count: int = None):
+        """
+        Get an array of geographic_msgs/msg/GeoPose objects for waypoints [start, start + count)
+        """
+        end = None if count is None else start + count
+        return latLonYaw2Geoposes(self.latitudes[start:end], self.longitudes[start:end],
+                                  self.yaws[start:end])
+
+
+class WaypointLogWriter:
+    """
+    Appends waypoints to a waypoint log. Records are synced to disk in batches: after
+    sync_batch records or sync_period seconds, whichever comes first
+    """
+
+    def __init__(self, log_file_path: str, sync_batch: int = 1, sync_period: float = 1.0):
+        self.sync_batch = sync_batch
+        self.sync_period = sync_period
+
+        # Drop a record torn by a previous crash, so new records stay aligned
+        self.fd = os.open(log_file_path, os.O_WRONLY | os.O_CREAT | os.O_APPEND, 0o644)
+        size = os.fstat(self.fd).st_size
+        if size % RECORD.size:
+            os.ftruncate(self.fd, size - size % RECORD.size)
+            os.fsync(self.fd)
+
+        self.unsynced = 0
+        self.last_sync = time.monotonic()
+
+    def append(self, latitude: float, longitude: float, yaw: float):
+        payload = struct.pack("<3d", latitude, longitude, yaw)
+        os.write(self.fd, RECORD.pack(RECORD_MAGIC, latitude, longitude, yaw,
+                                      zlib.crc32(payload)))
+        self.unsynced += 1
+        if self.unsynced >= self.sync_batch or \
+                time.monotonic() - self.last_sync >= self.sync_period:
+            self.sync()
+
+    def sync(self):
+        if self.unsynced:
+            os.fsync(self.fd)
+            self.unsynced = 0
+        self.last_sync = time.monotonic()
+
+    def close(self):
+        if self.fd is not None:
+            self.sync()
+            os.close(self.fd)
+            self.fd = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
@@ -0,0 +1,171 @@
+import math
+import os
+
+import numpy as np
+import yaml
+
+from nav2_gps_waypoint_follower_demo.utils.gps_utils import latLonYaw2Geoposes
+
+# Binary GPS route format, also read by include/nav2_gps_waypoint_follower_demo/
+# waypoint_route.hpp. All fields are little endian:
+#   header (40 bytes): magic, version, block_size, count, index_offset, data_offset
+#   index: one bounding box (min_lat, min_lon, max_lat, max_lon) per block_size waypoints
+#   data: count packed (latitude, longitude, yaw) doubles
+ROUTE_EXTENSION = ".gpsroute"
+ROUTE_MAGIC = b"N2GPSWPT"
+ROUTE_VERSION = 1
+
+HEADER_DTYPE = np.dtype([("magic", "S8"), ("version", "<u4"), ("block_size", "<u4"),
+                         ("count", "<u8"), ("index_offset", "<u8"), ("data_offset", "<u8")])
+BOUNDS_DTYPE = np.dtype([("min_lat", "<f8"), ("min_lon", "<f8"),
+                         ("max_lat", "<f8"), ("max_lon", "<f8")])
+WAYPOINT_DTYPE = np.dtype([("latitude", "<f8"), ("longitude", "<f8"), ("yaw", "<f8")])
+
+
+def write_route(file_path: str, latitudes, longitudes, yaws, block_size: int = 1024):
+    """
+    Writes waypoints to a binary route file
+    """
+    waypoints = np.empty(len(latitudes), dtype=WAYPOINT_DTYPE)
+    waypoints["latitude"] = latitudes
+    waypoints["longitude"] = longitudes
+    waypoints["yaw"] = yaws
+
+    blocks = (len(waypoints) + block_size - 1) // block_size
+    bounds = np.empty(blocks, dtype=BOUNDS_DTYPE)
+    if blocks > 0:
+        starts = np.arange(blocks) * block_size
+        bounds["min_lat"] = np.minimum.reduceat(waypoints["latitude"], starts)
+        bounds["min_lon"] = np.minimum.reduceat(waypoints["longitude"], starts)
+        bounds["max_lat"] = np.maximum.reduceat(waypoints["latitude"], starts)
+        bounds["max_lon"] = np.maximum.reduceat(waypoints["longitude"], starts)
+
+    header = np.zeros(1, dtype=HEADER_DTYPE)
+    header["magic"] = ROUTE_MAGIC
+    header["version"] = ROUTE_VERSION
+    header["block_size"] = block_size
+    header["count"] = len(waypoints)
+    header["index_offset"] = HEADER_DTYPE.itemsize
+    header["data_offset"] = HEADER_DTYPE.itemsize + bounds.nbytes
+
+    with open(file_path, "wb") as route_file:
+        route_file.write(header.tobytes())
+        route_file.write(bounds.tobytes())
+        route_file.write(waypoints.tobytes())
+
+
+def write_waypoints(file_path: str, latitudes, longitudes, yaws):
+    """
+    Writes waypoints to a binary route or, for any other extension, a demo_waypoints.yaml
+    layout yaml. Written aside and renamed, so the output is never left half written
+    """
+    tmp_file_path = file_path + ".tmp"
+    if file_path.endswith(ROUTE_EXTENSION):
+        write_route(tmp_file_path, latitudes, longitudes, yaws)
+    else:
+        data = {"waypoints": [
+            {"latitude": lat, "longitude": lon, "yaw": yaw}
+            for lat, lon, yaw in zip(np.asarray(latitudes).tolist(),
+                                     np.asarray(longitudes).tolist(),
+                                     np.asarray(yaws).tolist())]}
+        with open(tmp_file_path, 'w') as yaml_file:
+            yaml.dump(data, yaml_file, default_flow_style=False)
+    os.replace(tmp_file_path, file_path)
+
+
+class BinaryWaypointParser:
+    """
+    Parse a set of gps waypoints from a binary route file. The file is memory mapped,
+    so waypoints are only read when accessed
+    """
+
+    def __init__(self, wps_file_path: str) -> None:
+        header = np.fromfile(wps_file_path, dtype=HEADER_DTYPE, count=1)
+        if len(header) != 1 or header["magic"][0] != ROUTE_MAGIC or \
+                header["version"][0] != ROUTE_VERSION:
+            raise ValueError(f"{wps_file_path} is not a version {ROUTE_VERSION} gps route")
+        header = header[0]
+        count = int(header["count"])
+        self.block_size = int(header["block_size"])
+        blocks = (count + self.block_size - 1) // self.block_size
+
+        # numpy refuses to map empty files regions
+        self.bounds = np.memmap(wps_file_path, dtype=BOUNDS_DTYPE, mode="r",
+                                offset=int(header["index_offset"]),
+                                shape=(blocks,)) if blocks else np.empty(0, BOUNDS_DTYPE)
+        self.waypoints = np.memmap(wps_file_path, dtype=WAYPOINT_DTYPE, mode="r",
+                                   offset=int(header["data_offset"]),
+                                   shape=(count,)) if count else np.empty(0, WAYPOINT_DTYPE)
+
+    def __len__(self):
+        return len(self.waypoints)
+
+    def get_arrays(self):
+        """
+        Latitudes, longitudes and yaws of all waypoints, as views of the mapped file
+        """
+        return self.waypoints["latitude"], self.waypoints["longitude"], self.waypoints["yaw"]
+
+    def get_wps(self, start: int = 0, count: int = None):
+        """
+        Get an array of geographic_msgs/msg/GeoPose objects for waypoints [start, start + count)
+        """
+        wps = self.waypoints[start:None if count is None else start + count]
+        return latLonYaw2Geoposes(wps["latitude"], wps["longitude"], wps["yaw"])
+
+    def nearest(self, latitude: float, longitude: float) -> int:
+        """
+        Index of the waypoint closest to the given position, skipping the blocks whose
+        bounding box is farther than the best waypoint found so far
+        """
+        if len(self.waypoints) == 0:
+            return -1
+        # Equirectangular distances in degrees of latitude
+        scale = math.cos(math.radians(latitude))
+        dlat = np.maximum(np.maximum(self.bounds["min_lat"] - latitude,
+                                     latitude - self.bounds["max_lat"]), 0.0)
+        dlon = np.maximum(np.maximum(self.bounds["min_lon"] - longitude,
+                                     longitude - self.bounds["max_lon"]), 0.0) * scale
+        lower_bounds = dlat * dlat + dlon * dlon
+
+        best, best_dist = -1, math.inf
+        for block in np.argsort(lower_bounds, kind="stable"):
+            if lower_bounds[block] >= best_dist:
+                break
+            start = int(block) * self.block_size
+            wps = self.waypoints[start:start + self.block_size]
+            dist = (wps["latitude"] - latitude) ** 2 + \
+                ((wps["longitude"] - longitude) * scale) ** 2
+            i = int(np.argmin(dist))
+            if dist[i] < best_dist:
+                best, best_dist = start + i, dist[i]
+        return best
+
+
+class WaypointSubsetParser:
+    """
+    Exposes the waypoints of another parser at the given sorted indices
+    """
+
+    def __init__(self, wp_parser, indices):
+        self.wp_parser = wp_parser
+        self.indices = np.asarray(indices, dtype=np.int64)
+        latitudes, longitudes, yaws = wp_parser.get_arrays()
+        self.latitudes = latitudes[self.indices]
+        self.longitudes = longitudes[self.indices]
+        self.yaws = yaws[self.indices]
+
+    def __len__(self):
+        return len(self.indices)
+
+    def get_arrays(self):
+        return self.latitudes, self.longitudes, self.yaws
+
+    def get_wps(self, start: int = 0, count: int = None):
+        """
+        Get an array of geographic_msgs/msg/GeoPose objects for subset waypoints
+        [start, start + count)
+        """
+        end = None if count is None else start + count
+        return latLonYaw2Geoposes(self.latitudes[start:end], self.longitudes[start:end],
+                                  self.yaws[start:end])
@@ -0,0 +1,36 @@
+import sys
+
+import numpy as np
+import yaml
+
+from nav2_gps_waypoint_follower_demo.utils.waypoint_route import ROUTE_EXTENSION, write_route
+
+
+def main():
+    """
+    Converts a waypoints yaml file (demo_waypoints.yaml layout) to a binary gps route
+    """
+    if len(sys.argv) < 2:
+        print(f"Usage: waypoints_to_route <waypoints.yaml> [output{ROUTE_EXTENSION}]")
+        sys.exit(1)
+
+    yaml_file_path = sys.argv[1]
+    if len(sys.argv) > 2:
+        route_file_path = sys.argv[2]
+    else:
+        route_file_path = yaml_file_path.rsplit(".", 1)[0] + ROUTE_EXTENSION
+
+    # The C loader is much faster on large files, when available
+    loader = getattr(yaml, "CSafeLoader", yaml.SafeLoader)
+    with open(yaml_file_path, 'r') as wps_file:
+        wps = yaml.load(wps_file, Loader=loader)["waypoints"]
+
+    write_route(route_file_path,
+                np.fromiter((wp["latitude"] for wp in wps), np.float64, len(wps)),
+                np.fromiter((wp["longitude"] for wp in wps), np.float64, len(wps)),
+                np.fromiter((wp["yaw"] for wp in wps), np.float64, len(wps)))
+    print(f"Wrote {len(wps)} waypoints to {route_file_path}")
+
+
+if __name__ == "__main__":
+    main()
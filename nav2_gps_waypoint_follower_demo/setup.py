@@ -18,6 +18,7 @@ setup(
         (os.path.join('share', package_name, 'worlds'), glob('worlds/*')),
         (os.path.join('share', package_name, 'models/turtlebot_waffle_gps'),
          glob('models/turtlebot_waffle_gps/*')),
+        (os.path.join('include', package_name), glob('include/' + package_name + '/*.hpp')),
     ],
     install_requires=['setuptools'],
     zip_safe=True,
@@ -30,7 +31,15 @@ setup(
         'console_scripts': [
             'logged_waypoint_follower = nav2_gps_waypoint_follower_demo.logged_waypoint_follower:main',
             'interactive_waypoint_follower = nav2_gps_waypoint_follower_demo.interactive_waypoint_follower:main',
-            'gps_waypoint_logger = nav2_gps_waypoint_follower_demo.gps_waypoint_logger:main'
+            'gps_waypoint_logger = nav2_gps_waypoint_follower_demo.gps_waypoint_logger:main',
+            'waypoints_to_route = nav2_gps_waypoint_follower_demo.waypoints_to_route:main',
+            'streaming_waypoint_follower = nav2_gps_waypoint_follower_demo.streaming_waypoint_follower:main',
+            'compact_waypoint_log = nav2_gps_waypoint_follower_demo.compact_waypoint_log:main',
+            'decimate_route = nav2_gps_waypoint_follower_demo.decimate_route:main',
+            'gnss_simulator = nav2_gps_waypoint_follower_demo.gnss_simulator:main',
+            'gps_pipeline_benchmark = nav2_gps_waypoint_follower_demo.gps_pipeline_benchmark:main',
+            'ekf_profiler = nav2_gps_waypoint_follower_demo.ekf_profiler:main',
+            'profile_dual_ekf = nav2_gps_waypoint_follower_demo.profile_dual_ekf:main'
         ],
     },
 )
@@ -0,0 +1,118 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+#ifndef NAV2_KEEPOUT_SPEED_COSTMAP_PLUGIN__KEEPOUT_SPEED_LAYER_HPP_
+#define NAV2_KEEPOUT_SPEED_COSTMAP_PLUGIN__KEEPOUT_SPEED_LAYER_HPP_
+
+#include <mutex>
+#include <string>
+
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_costmap_2d/layer.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+#include "nav2_msgs/msg/speed_limit.hpp"
+#include "nav_msgs/msg/occupancy_grid.hpp"
+
+namespace nav2_keepout_speed_costmap_plugin
+{
+
+// Applies the keepout and the speed filter masks of the costmap filters demo
+// from a single layer: one subscription per mask, no filter info servers and
+// one pass over the update window instead of one per filter instance.
+class KeepoutSpeedLayer : public nav2_costmap_2d::Layer
+{
+public:
+  KeepoutSpeedLayer();
+
+  virtual void onInitialize();
+  virtual void updateBounds(
+    double robot_x, double robot_y, double robot_yaw, double * min_x,
+    double * min_y,
+    double * max_x,
+    double * max_y);
+  virtual void updateCosts(
+    nav2_costmap_2d::Costmap2D & master_grid,
+    int min_i, int min_j, int max_i, int max_j);
+
+  virtual void activate();
+  virtual void deactivate();
+
+  virtual void reset()
+  {
+    return;
+  }
+
+  virtual bool isClearable() {return false;}
+
+private:
+  // Planar transform from the costmap global frame to a mask frame
+  struct MaskTransform
+  {
+    double x, y, cos_yaw, sin_yaw;
+  };
+
+  void keepoutMaskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg);
+  void speedMaskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg);
+
+  // Looks up the transform from the costmap global frame to the mask frame
+  bool getMaskTransform(const std::string & mask_frame, MaskTransform & transform);
+
+  // Publishes the speed limit of the mask cell under the robot if it changed
+  void updateSpeedLimit(const nav_msgs::msg::OccupancyGrid & speed_mask);
+
+  // Masks and their update flag are shared with the subscription callbacks
+  std::mutex mask_mutex_;
+  nav_msgs::msg::OccupancyGrid::SharedPtr keepout_mask_;
+  nav_msgs::msg::OccupancyGrid::SharedPtr speed_mask_;
+  // A new keepout mask requires the whole costmap to be updated
+  bool need_recalculation_;
+
+  rclcpp::Subscription<nav_msgs::msg::OccupancyGrid>::SharedPtr keepout_mask_sub_;
+  rclcpp::Subscription<nav_msgs::msg::OccupancyGrid>::SharedPtr speed_mask_sub_;
+  rclcpp_lifecycle::LifecyclePublisher<nav2_msgs::msg::SpeedLimit>::SharedPtr speed_limit_pub_;
+
+  // Keepout mask value [0..100] to costmap cost
+  unsigned char keepout_cost_lut_[101];
+  // Mask value to speed limit: base + multiplier * value, as in speed_params.yaml
+  double speed_base_, speed_multiplier_;
+  bool speed_limit_in_percent_;
+  double last_speed_limit_;
+
+  // Robot pose from the last updateBounds() call, in the costmap global frame
+  double robot_x_, robot_y_;
+};
+
+}  // namespace nav2_keepout_speed_costmap_plugin
+
+#endif  // NAV2_KEEPOUT_SPEED_COSTMAP_PLUGIN__KEEPOUT_SPEED_LAYER_HPP_
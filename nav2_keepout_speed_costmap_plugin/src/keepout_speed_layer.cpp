@@ -0,0 +1,328 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+#include "nav2_keepout_speed_costmap_plugin/keepout_speed_layer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "tf2/utils.h"
+
+using nav2_costmap_2d::LETHAL_OBSTACLE;
+using nav2_costmap_2d::FREE_SPACE;
+using nav2_costmap_2d::NO_INFORMATION;
+
+namespace nav2_keepout_speed_costmap_plugin
+{
+
+// Same value as nav2_costmap_2d::NO_SPEED_LIMIT used by the SpeedFilter
+static constexpr double NO_SPEED_LIMIT = 0.0;
+
+KeepoutSpeedLayer::KeepoutSpeedLayer()
+: need_recalculation_(false),
+  last_speed_limit_(NO_SPEED_LIMIT),
+  robot_x_(0.0),
+  robot_y_(0.0)
+{
+}
+
+// This method is called at the end of plugin initialization.
+// It declares the parameters, builds the keepout cost table and subscribes
+// to both filter masks published by the costmap filters demo.
+void
+KeepoutSpeedLayer::onInitialize()
+{
+  auto node = node_.lock();
+  declareParameter("enabled", rclcpp::ParameterValue(true));
+  node->get_parameter(name_ + "." + "enabled", enabled_);
+
+  // Topics and conversions are matching nav2_costmap_filters_demo/params
+  declareParameter("keepout_mask_topic", rclcpp::ParameterValue("/keepout_filter_mask"));
+  declareParameter("speed_mask_topic", rclcpp::ParameterValue("/speed_filter_mask"));
+  declareParameter("speed_limit_topic", rclcpp::ParameterValue("speed_limit"));
+  declareParameter("speed_base", rclcpp::ParameterValue(100.0));
+  declareParameter("speed_multiplier", rclcpp::ParameterValue(-1.0));
+  declareParameter("speed_limit_in_percent", rclcpp::ParameterValue(true));
+
+  std::string keepout_mask_topic, speed_mask_topic, speed_limit_topic;
+  node->get_parameter(name_ + "." + "keepout_mask_topic", keepout_mask_topic);
+  node->get_parameter(name_ + "." + "speed_mask_topic", speed_mask_topic);
+  node->get_parameter(name_ + "." + "speed_limit_topic", speed_limit_topic);
+  node->get_parameter(name_ + "." + "speed_base", speed_base_);
+  node->get_parameter(name_ + "." + "speed_multiplier", speed_multiplier_);
+  node->get_parameter(name_ + "." + "speed_limit_in_percent", speed_limit_in_percent_);
+
+  // Keepout mask values are scaled from [0..100] to [FREE_SPACE..LETHAL_OBSTACLE]
+  for (int value = 0; value <= 100; value++) {
+    keepout_cost_lut_[value] = static_cast<unsigned char>(
+      std::round(FREE_SPACE + value * (LETHAL_OBSTACLE - FREE_SPACE) / 100.0));
+  }
+
+  // Filter masks are published once by latched mask servers
+  const auto mask_qos = rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable();
+  if (!keepout_mask_topic.empty()) {
+    keepout_mask_sub_ = node->create_subscription<nav_msgs::msg::OccupancyGrid>(
+      keepout_mask_topic, mask_qos,
+      std::bind(&KeepoutSpeedLayer::keepoutMaskCallback, this, std::placeholders::_1));
+  }
+  if (!speed_mask_topic.empty()) {
+    speed_mask_sub_ = node->create_subscription<nav_msgs::msg::OccupancyGrid>(
+      speed_mask_topic, mask_qos,
+      std::bind(&KeepoutSpeedLayer::speedMaskCallback, this, std::placeholders::_1));
+    speed_limit_pub_ = node->create_publisher<nav2_msgs::msg::SpeedLimit>(
+      speed_limit_topic, rclcpp::QoS(10));
+  }
+
+  current_ = true;
+}
+
+void
+KeepoutSpeedLayer::activate()
+{
+  if (speed_limit_pub_) {
+    speed_limit_pub_->on_activate();
+  }
+}
+
+void
+KeepoutSpeedLayer::deactivate()
+{
+  if (speed_limit_pub_) {
+    speed_limit_pub_->on_deactivate();
+  }
+}
+
+void
+KeepoutSpeedLayer::keepoutMaskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(mask_mutex_);
+  keepout_mask_ = msg;
+  need_recalculation_ = true;
+}
+
+void
+KeepoutSpeedLayer::speedMaskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(mask_mutex_);
+  speed_mask_ = msg;
+}
+
+// The method is called to ask the plugin: which area of costmap it needs to update.
+// Like other costmap filters, this layer only applies masks inside the window set
+// by other layers, except after a new keepout mask arrived.
+void
+KeepoutSpeedLayer::updateBounds(
+  double robot_x, double robot_y, double /*robot_yaw*/, double * min_x,
+  double * min_y, double * max_x, double * max_y)
+{
+  if (!enabled_) {
+    return;
+  }
+
+  robot_x_ = robot_x;
+  robot_y_ = robot_y;
+
+  std::lock_guard<std::mutex> lock(mask_mutex_);
+  if (need_recalculation_) {
+    *min_x = -std::numeric_limits<float>::max();
+    *min_y = -std::numeric_limits<float>::max();
+    *max_x = std::numeric_limits<float>::max();
+    *max_y = std::numeric_limits<float>::max();
+    need_recalculation_ = false;
+  }
+}
+
+bool
+KeepoutSpeedLayer::getMaskTransform(const std::string & mask_frame, MaskTransform & transform)
+{
+  const std::string global_frame = layered_costmap_->getGlobalFrameID();
+  if (mask_frame == global_frame) {
+    transform = MaskTransform{0.0, 0.0, 1.0, 0.0};
+    return true;
+  }
+
+  geometry_msgs::msg::TransformStamped tf_transform;
+  try {
+    tf_transform = tf_->lookupTransform(mask_frame, global_frame, tf2::TimePointZero);
+  } catch (tf2::TransformException & ex) {
+    RCLCPP_WARN(
+      logger_, "KeepoutSpeedLayer: failed to get %s->%s transform: %s",
+      global_frame.c_str(), mask_frame.c_str(), ex.what());
+    return false;
+  }
+
+  const double yaw = tf2::getYaw(tf_transform.transform.rotation);
+  transform = MaskTransform{
+    tf_transform.transform.translation.x, tf_transform.transform.translation.y,
+    std::cos(yaw), std::sin(yaw)};
+  return true;
+}
+
+void
+KeepoutSpeedLayer::updateSpeedLimit(const nav_msgs::msg::OccupancyGrid & speed_mask)
+{
+  MaskTransform transform;
+  if (!getMaskTransform(speed_mask.header.frame_id, transform)) {
+    return;
+  }
+
+  const double wx = transform.x + transform.cos_yaw * robot_x_ - transform.sin_yaw * robot_y_;
+  const double wy = transform.y + transform.sin_yaw * robot_x_ + transform.cos_yaw * robot_y_;
+  const double mx = std::floor(
+    (wx - speed_mask.info.origin.position.x) / speed_mask.info.resolution);
+  const double my = std::floor(
+    (wy - speed_mask.info.origin.position.y) / speed_mask.info.resolution);
+
+  // Same conventions as the SpeedFilter: unknown and 0 mask values mean no limit
+  double speed_limit = NO_SPEED_LIMIT;
+  if (mx >= 0.0 && my >= 0.0 && mx < speed_mask.info.width && my < speed_mask.info.height) {
+    const signed char value = speed_mask.data[
+      static_cast<size_t>(my) * speed_mask.info.width + static_cast<size_t>(mx)];
+    if (value > 0) {
+      speed_limit = speed_base_ + speed_multiplier_ * value;
+      if (speed_limit_in_percent_) {
+        speed_limit = std::min(std::max(speed_limit, 0.0), 100.0);
+      } else {
+        speed_limit = std::max(speed_limit, 0.0);
+      }
+    }
+  }
+
+  if (speed_limit == last_speed_limit_) {
+    return;
+  }
+  last_speed_limit_ = speed_limit;
+
+  auto msg = std::make_unique<nav2_msgs::msg::SpeedLimit>();
+  msg->header.frame_id = layered_costmap_->getGlobalFrameID();
+  msg->header.stamp = clock_->now();
+  msg->percentage = speed_limit_in_percent_;
+  msg->speed_limit = speed_limit;
+  speed_limit_pub_->publish(std::move(msg));
+}
+
+// The method is called when costmap recalculation is required.
+// The keepout mask is applied with a single row-major pass over the window:
+// mask coordinates change linearly along a costmap row, so each cell costs two
+// additions and one table lookup, with no transform call per cell.
+// The speed limit is evaluated at the robot pose within the same update.
+void
+KeepoutSpeedLayer::updateCosts(
+  nav2_costmap_2d::Costmap2D & master_grid, int min_i, int min_j,
+  int max_i,
+  int max_j)
+{
+  if (!enabled_) {
+    return;
+  }
+
+  nav_msgs::msg::OccupancyGrid::SharedPtr keepout_mask, speed_mask;
+  {
+    std::lock_guard<std::mutex> lock(mask_mutex_);
+    keepout_mask = keepout_mask_;
+    speed_mask = speed_mask_;
+  }
+
+  if (speed_mask && speed_limit_pub_) {
+    updateSpeedLimit(*speed_mask);
+  }
+
+  MaskTransform transform;
+  if (!keepout_mask || !getMaskTransform(keepout_mask->header.frame_id, transform)) {
+    return;
+  }
+
+  unsigned char * master_array = master_grid.getCharMap();
+  unsigned int size_x = master_grid.getSizeInCellsX(), size_y = master_grid.getSizeInCellsY();
+
+  // Fixing window coordinates with map size if necessary.
+  min_i = std::max(0, min_i);
+  min_j = std::max(0, min_j);
+  max_i = std::min(static_cast<int>(size_x), max_i);
+  max_j = std::min(static_cast<int>(size_y), max_j);
+
+  const double resolution = master_grid.getResolution();
+  const double origin_x = master_grid.getOriginX();
+  const double origin_y = master_grid.getOriginY();
+
+  const auto & info = keepout_mask->info;
+  const double mask_width = info.width;
+  const double mask_height = info.height;
+  const signed char * mask_data = keepout_mask->data.data();
+
+  // Mask cell increments for one costmap cell step along a row
+  const double step_x = transform.cos_yaw * resolution / info.resolution;
+  const double step_y = transform.sin_yaw * resolution / info.resolution;
+
+  for (int j = min_j; j < max_j; j++) {
+    // Center of the first window cell of the row, in the mask frame
+    const double wx = origin_x + (min_i + 0.5) * resolution;
+    const double wy = origin_y + (j + 0.5) * resolution;
+    double mx = (transform.x + transform.cos_yaw * wx - transform.sin_yaw * wy -
+      info.origin.position.x) / info.resolution;
+    double my = (transform.y + transform.sin_yaw * wx + transform.cos_yaw * wy -
+      info.origin.position.y) / info.resolution;
+
+    unsigned char * row = master_array + static_cast<size_t>(j) * size_x;
+    for (int i = min_i; i < max_i; i++, mx += step_x, my += step_y) {
+      if (mx < 0.0 || my < 0.0 || mx >= mask_width || my >= mask_height) {
+        continue;
+      }
+      const signed char value =
+        mask_data[static_cast<size_t>(my) * info.width + static_cast<size_t>(mx)];
+      if (value < 0 || value > 100) {
+        continue;
+      }
+      // Keepout never lowers costs set by other layers
+      const unsigned char cost = keepout_cost_lut_[value];
+      if (row[i] == NO_INFORMATION || cost > row[i]) {
+        row[i] = cost;
+      }
+    }
+  }
+}
+
+}  // namespace nav2_keepout_speed_costmap_plugin
+
+// This is the macro allowing a nav2_keepout_speed_costmap_plugin::KeepoutSpeedLayer class
+// to be registered in order to be dynamically loadable of base type nav2_costmap_2d::Layer.
+// Usually places in the end of cpp-file where the loadable class written.
+#include "pluginlib/class_list_macros.hpp"
+PLUGINLIB_EXPORT_CLASS(nav2_keepout_speed_costmap_plugin::KeepoutSpeedLayer, nav2_costmap_2d::Layer)
@@ -0,0 +1,151 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__COMPACT_PATH_EXPANDER_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__COMPACT_PATH_EXPANDER_HPP_
+
+#include <cmath>
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "nav_msgs/msg/path.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "nav2_straightline_planner/msg/compact_path.hpp"
+#include "nav2_straightline_planner/trapezoid_profile.hpp"
+
+namespace nav2_straightline_planner
+{
+
+// Expands a CompactPath into the nav_msgs/Path the StraightLine planner made of it,
+// pose for pose. Header-only, consumers only need the CompactPath message.
+inline nav_msgs::msg::Path expandCompactPath(const msg::CompactPath & compact)
+{
+  nav_msgs::msg::Path path;
+  path.header = compact.header;
+  const auto & corners = compact.corners;
+  if (corners.size() < 2 || compact.resolution <= 0.0) {
+    return path;
+  }
+
+  auto leg_loops = [&](size_t leg) {
+      return static_cast<int>(std::hypot(
+               corners[leg + 1].x - corners[leg].x,
+               corners[leg + 1].y - corners[leg].y) / compact.resolution);
+    };
+  size_t total_poses = 1;
+  for (size_t leg = 0; leg + 1 < corners.size(); ++leg) {
+    total_poses += leg_loops(leg);
+  }
+  if (compact.skipped_poses >= total_poses) {
+    return path;
+  }
+  path.poses.reserve(total_poses - compact.skipped_poses);
+
+  const rclcpp::Time stamp(compact.header.stamp);
+  const bool timed = compact.max_velocity > 0.0;
+  // Time of the first pose of the path along the profile
+  rclcpp::Duration first_time(0, 0);
+  size_t index = 0;
+  auto add_pose = [&](const geometry_msgs::msg::PoseStamped & pose, double time) {
+      if (index++ < compact.skipped_poses) {
+        return;
+      }
+      const rclcpp::Duration pose_time = rclcpp::Duration::from_seconds(time);
+      if (path.poses.empty()) {
+        first_time = pose_time;
+      }
+      path.poses.push_back(pose);
+      auto & added = path.poses.back();
+      added.header.stamp = timed ? stamp + (pose_time - first_time) : stamp;
+      if (path.poses.size() == 1) {
+        added.pose.position = compact.start;
+      }
+    };
+
+  geometry_msgs::msg::PoseStamped pose;
+  pose.header.frame_id = compact.header.frame_id;
+  TrapezoidProfile leg_profile;
+  double leg_start = 0.0;
+  for (size_t leg = 0; leg + 1 < corners.size(); ++leg) {
+    const auto & from = corners[leg];
+    const auto & to = corners[leg + 1];
+    const int total_number_of_loop = leg_loops(leg);
+    if (total_number_of_loop == 0) {
+      // Shorter than the resolution, the leg has no poses but is still driven
+      if (timed) {
+        leg_profile.configure(
+          std::hypot(to.x - from.x, to.y - from.y), compact.max_velocity,
+          compact.max_acceleration);
+        leg_start += leg_profile.duration();
+      }
+      continue;
+    }
+    const double x_increment = (to.x - from.x) / total_number_of_loop;
+    const double y_increment = (to.y - from.y) / total_number_of_loop;
+
+    double leg_step = 0.0;
+    if (timed) {
+      const double leg_length = std::hypot(to.x - from.x, to.y - from.y);
+      leg_step = leg_length / total_number_of_loop;
+      leg_profile.configure(leg_length, compact.max_velocity, compact.max_acceleration);
+    }
+
+    pose.pose.orientation = geometry_msgs::msg::Quaternion();
+    pose.pose.orientation.w = 1.0;
+    if (compact.leg_headings) {
+      const double yaw = std::atan2(to.y - from.y, to.x - from.x);
+      pose.pose.orientation.z = std::sin(yaw / 2.0);
+      pose.pose.orientation.w = std::cos(yaw / 2.0);
+    }
+
+    for (int i = 0; i < total_number_of_loop; ++i) {
+      pose.pose.position.x = from.x + x_increment * i;
+      pose.pose.position.y = from.y + y_increment * i;
+      pose.pose.position.z = 0.0;
+      add_pose(pose, timed ? leg_start + leg_profile.timeAt(leg_step * i) : 0.0);
+    }
+    if (timed) {
+      leg_start += leg_profile.duration();
+    }
+  }
+
+  pose.pose.position = corners.back();
+  pose.pose.orientation = compact.goal_orientation;
+  add_pose(pose, leg_start);
+  return path;
+}
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__COMPACT_PATH_EXPANDER_HPP_
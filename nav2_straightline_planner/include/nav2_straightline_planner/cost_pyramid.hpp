@@ -0,0 +1,107 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__COST_PYRAMID_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__COST_PYRAMID_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace nav2_straightline_planner
+{
+
+// Max-pooled pyramid of a row-major grid of costs. Level 0 is the grid itself, every
+// cell of level l holds the highest cost of a BLOCK_SIZE^l cells block of the grid, so a
+// block whose value is below a collision threshold can be skipped as a whole.
+// Unknown cells (NO_INFORMATION), and the cells of edge blocks lying past the grid,
+// are pooled as unknown_cost.
+class CostPyramid
+{
+public:
+  static constexpr unsigned int BLOCK_SIZE = 8;
+
+  CostPyramid() = default;
+
+  // Number of pooled levels above the grid; clears the pyramid
+  void configure(unsigned int levels, unsigned char unknown_cost);
+
+  // Pools the whole grid
+  void rebuild(const unsigned char * costs, unsigned int size_x, unsigned int size_y);
+
+  // Pools again the blocks over grid cells [min_x, max_x) x [min_y, max_y) only,
+  // falling back to a full rebuild if the grid size changed
+  void update(
+    const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+    unsigned int min_x, unsigned int min_y, unsigned int max_x, unsigned int max_y);
+
+  // Number of pooled levels, 0 until built
+  unsigned int levels() const {return built_ ? levels_.size() : 0;}
+
+  // Grid cells covered by a cell of given level, along each axis
+  unsigned int blockSize(unsigned int level) const {return block_sizes_[level];}
+
+  unsigned int sizeX(unsigned int level) const {return levels_[level - 1].size_x;}
+  unsigned int sizeY(unsigned int level) const {return levels_[level - 1].size_y;}
+
+  // Highest cost of the block (x, y) of a level >= 1, which has to be in the level
+  unsigned char blockMax(unsigned int level, unsigned int x, unsigned int y) const
+  {
+    const Level & l = levels_[level - 1];
+    return l.costs[static_cast<size_t>(y) * l.size_x + x];
+  }
+
+private:
+  struct Level
+  {
+    unsigned int size_x;
+    unsigned int size_y;
+    std::vector<unsigned char> costs;
+  };
+
+  // Pools level cells [min_x, max_x) x [min_y, max_y) from the level below
+  void pool(
+    unsigned int level, const unsigned char * costs,
+    unsigned int min_x, unsigned int min_y, unsigned int max_x, unsigned int max_y);
+
+  unsigned char unknown_cost_{255};
+  unsigned int grid_size_x_{0}, grid_size_y_{0};
+  bool built_{false};
+  std::vector<unsigned int> block_sizes_;
+  std::vector<Level> levels_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__COST_PYRAMID_HPP_
@@ -0,0 +1,100 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__COSTMAP_SNAPSHOT_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__COSTMAP_SNAPSHOT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nav2_straightline_planner
+{
+
+// Row span [min_x, max_x] of costmap cells
+struct CellSpan
+{
+  int row;
+  int min_x;
+  int max_x;
+};
+
+// Copy of the costmap cells under a list of row spans, one span per row in increasing
+// row order, as swept by SegmentCollisionChecker. Capturing it only takes one memcpy
+// per row, so the costmap can be locked just for the copy and checked afterwards.
+class CostmapSnapshot
+{
+public:
+  CostmapSnapshot() = default;
+
+  // Copies the cells of the spans, clipped to the grid, reusing the storage
+  void capture(
+    const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+    const std::vector<CellSpan> & spans);
+
+  // FNV-1a hash of the copied cells and their positions, telling apart the snapshots of
+  // different costmap contents under the same spans
+  uint32_t checksum() const;
+
+  // Copied cells [min_x, max_x] of a row, from the one at min_x;
+  // nullptr if nothing of the row was copied
+  const unsigned char * row(int y, int & min_x, int & max_x) const
+  {
+    const int r = y - first_row_;
+    if (r < 0 || r >= static_cast<int>(rows_.size()) || rows_[r].min_x > rows_[r].max_x) {
+      return nullptr;
+    }
+    min_x = rows_[r].min_x;
+    max_x = rows_[r].max_x;
+    return costs_.data() + rows_[r].offset;
+  }
+
+private:
+  struct Row
+  {
+    int min_x;
+    int max_x;
+    // Start of the row cells in costs_
+    size_t offset;
+  };
+
+  int first_row_{0};
+  std::vector<Row> rows_;
+  std::vector<unsigned char> costs_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__COSTMAP_SNAPSHOT_HPP_
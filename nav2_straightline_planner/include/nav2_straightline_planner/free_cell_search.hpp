@@ -0,0 +1,75 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__FREE_CELL_SEARCH_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__FREE_CELL_SEARCH_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace nav2_straightline_planner
+{
+
+// Bounded breadth-first search of the free cell closest to a grid cell. The search never
+// leaves the square window of max_radius cells around the start, so its visited stamps
+// and its queue are window-sized and allocated once by configure(). Visited cells are
+// stamped with a per-search epoch, which spares clearing them between searches.
+class FreeCellSearch
+{
+public:
+  FreeCellSearch() = default;
+
+  void configure(unsigned int max_radius);
+
+  // Finds the cell closest (euclidean) to (x, y) whose cost is below cost_threshold,
+  // unknown cells (NO_INFORMATION) being free if allow_unknown. Returns false if
+  // there is none within max_radius cells (euclidean)
+  bool find(
+    const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+    unsigned int x, unsigned int y, unsigned char cost_threshold, bool allow_unknown,
+    unsigned int & free_x, unsigned int & free_y);
+
+private:
+  int max_radius_{0};
+  int window_size_{1};
+  uint32_t epoch_{0};
+  std::vector<uint32_t> visited_;
+  // Window indices of the queued cells; every cell is queued at most once per search
+  std::vector<uint32_t> queue_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__FREE_CELL_SEARCH_HPP_
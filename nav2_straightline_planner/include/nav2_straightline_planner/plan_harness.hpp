@@ -0,0 +1,96 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__PLAN_HARNESS_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__PLAN_HARNESS_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "nav2_core/global_planner.hpp"
+#include "nav2_costmap_2d/costmap_2d_ros.hpp"
+#include "nav2_util/lifecycle_node.hpp"
+#include "pluginlib/class_loader.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "tf2_ros/buffer.h"
+#include "tf2_ros/static_transform_broadcaster.h"
+
+namespace nav2_straightline_planner
+{
+
+// Planner plugin on a paused global costmap, shared by the replay_plans and stress_plans
+// tools. The global_costmap and the plugin are configured from the node parameters, the
+// plugin being the one named by the planner_plugin parameter (StraightLine by default),
+// under plugin_name. The robot is pinned to the global frame origin, and the costmap is
+// paused once current so that every request is planned on the same cells.
+class PlanHarness
+{
+public:
+  // Throws std::runtime_error if the plugin can't be loaded
+  PlanHarness(
+    const std::string & node_name, const std::string & plugin_name,
+    const rclcpp::NodeOptions & options = rclcpp::NodeOptions());
+  ~PlanHarness();
+
+  nav2_core::GlobalPlanner & planner() {return *planner_;}
+  const nav2_costmap_2d::Costmap2D & costmap() const {return *costmap_ros_->getCostmap();}
+  std::string globalFrame() const {return costmap_ros_->getGlobalFrameID();}
+
+  // Stops spinning the node, then deactivates and cleans up the planner and the costmap.
+  // Called by the destructor if not before
+  void shutdown();
+
+private:
+  nav2_util::LifecycleNode::SharedPtr node_;
+  std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
+  std::unique_ptr<tf2_ros::StaticTransformBroadcaster> tf_broadcaster_;
+  // Outlives the plugin it loaded
+  pluginlib::ClassLoader<nav2_core::GlobalPlanner> loader_;
+  nav2_core::GlobalPlanner::Ptr planner_;
+  // Timers and subscriptions of the plugin, e.g. the latched speed mask
+  rclcpp::executors::SingleThreadedExecutor executor_;
+  std::thread spin_thread_;
+  bool active_{false};
+};
+
+// Planning time percentile [ms] of durations [ns], nearest rank below. Reorders durations_ns
+double percentileMs(std::vector<int64_t> & durations_ns, double percentile);
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__PLAN_HARNESS_HPP_
@@ -0,0 +1,146 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__PLAN_RECORDER_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__PLAN_RECORDER_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nav2_straightline_planner
+{
+
+// Inputs and outcome of one plan request, as written to a plan log.
+// Logs are a "SLPLAN02" magic, the number of records dropped by the recorder (uint64, set
+// when the log is closed) and the records, in host byte order.
+struct PlanRecord
+{
+  // Request time since the epoch [ns]
+  int64_t stamp_ns;
+  // Planar start and goal poses: position and yaw quaternion z, w
+  double start_x, start_y, start_qz, start_qw;
+  double goal_x, goal_y, goal_qz, goal_qw;
+  // Via points of the request, which are not logged
+  uint32_t via_points;
+  // CostmapSnapshot::checksum() of the checked costmap cells, 0 if none were checked
+  uint32_t costmap_checksum;
+  // Poses of the returned path, 0 if planning failed
+  uint32_t path_poses;
+  // Records dropped by the recorder between the previous record of the log and this one
+  uint32_t dropped_before;
+  // Planning time [ns]
+  int64_t duration_ns;
+};
+
+static_assert(sizeof(PlanRecord) == 96, "PlanRecord has to keep its log layout");
+
+constexpr char PLAN_LOG_MAGIC[] = "SLPLAN02";
+
+struct PlanLog
+{
+  std::vector<PlanRecord> records;
+  // Records dropped by the recorder, 0 in logs not closed properly. More than the sum of
+  // dropped_before when the last records were dropped
+  uint64_t dropped;
+};
+
+// Reads all the records of a plan log. Throws std::runtime_error on failure
+PlanLog readPlanLog(const std::string & filename);
+
+// Appends plan records to a plan log from any number of planning threads without
+// blocking them. Records go through a bounded lock-free ring buffer (multi producer,
+// single consumer) drained to the file by a writer thread; records arriving while the
+// ring is full are dropped and counted in the log, so that a reader can tell them from
+// a truncated log.
+class PlanRecorder
+{
+public:
+  // Creates the log, throws std::runtime_error if it can't be opened.
+  // The capacity of the ring is rounded up to a power of two
+  PlanRecorder(const std::string & filename, size_t capacity);
+
+  // Writes the records left in the ring and the drop count, and closes the log
+  ~PlanRecorder();
+
+  PlanRecorder(const PlanRecorder &) = delete;
+  PlanRecorder & operator=(const PlanRecorder &) = delete;
+
+  // Queues a record, returns false if the ring is full
+  bool record(const PlanRecord & plan_record);
+
+  // Records dropped so far because the ring was full
+  uint64_t dropped() const {return dropped_.load(std::memory_order_relaxed);}
+
+private:
+  struct Slot
+  {
+    // Ring position the slot is ready for: written when equal to the enqueue position,
+    // readable when one past the dequeue position
+    std::atomic<size_t> sequence;
+    PlanRecord record;
+  };
+
+  // Moves the next record out of the ring, writer thread only
+  bool take(PlanRecord & plan_record);
+
+  void writerLoop();
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+  // Next slot claimed by the producers, next slot read by the writer
+  std::atomic<size_t> enqueue_position_{0};
+  size_t dequeue_position_{0};
+  std::atomic<uint64_t> dropped_{0};
+  // Drops not yet attached to a queued record
+  std::atomic<uint32_t> pending_drops_{0};
+
+  FILE * file_;
+  std::atomic<bool> stop_{false};
+  // Only used to put the idle writer to sleep, producers never take it
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::thread writer_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__PLAN_RECORDER_HPP_
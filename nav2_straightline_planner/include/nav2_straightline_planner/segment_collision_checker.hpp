@@ -0,0 +1,174 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__SEGMENT_COLLISION_CHECKER_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__SEGMENT_COLLISION_CHECKER_HPP_
+
+#include <vector>
+
+#include "geometry_msgs/msg/point.hpp"
+#include "nav2_straightline_planner/cost_pyramid.hpp"
+#include "nav2_straightline_planner/costmap_snapshot.hpp"
+
+namespace nav2_straightline_planner
+{
+
+// Collision checks of straight segments against a row-major grid of costs.
+// A cell blocks the robot when its cost is at least cost_threshold; unknown cells
+// (NO_INFORMATION) and cells outside of the grid block it unless allow_unknown is set.
+class SegmentCollisionChecker
+{
+public:
+  SegmentCollisionChecker() = default;
+
+  void setCostThreshold(unsigned char cost_threshold, bool allow_unknown);
+
+  // Grid to check; costs has to outlive the checks and can be nullptr with a snapshot
+  void setGrid(
+    const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+    double resolution, double origin_x, double origin_y);
+
+  // Max-pooled pyramid of the grid, built with the unknown cost of this checker, letting
+  // the checks skip whole blocks below the threshold; nullptr to check every cell
+  void setPyramid(const CostPyramid * pyramid) {pyramid_ = pyramid;}
+
+  // Copy of the grid cells under spans() to read instead of the grid costs, or nullptr.
+  // Cells of the grid missing from the snapshot are considered blocking
+  void setSnapshot(const CostmapSnapshot * snapshot) {snapshot_ = snapshot;}
+
+  // Rasterizes the area swept by the footprint along the segment into spans(), see
+  // footprintCollides()
+  void sweepFootprint(
+    double wx0, double wy0, double wx1, double wy1,
+    const std::vector<geometry_msgs::msg::Point> & footprint);
+
+  // Same, the robot first turning in place at the start of the segment from start_yaw to
+  // face its direction, the shorter way. A segment of zero length keeps facing start_yaw
+  void sweepFootprint(
+    double wx0, double wy0, double wx1, double wy1, double start_yaw,
+    const std::vector<geometry_msgs::msg::Point> & footprint);
+
+  // Rasterizes the segment centre line into spans(), widened by a cell on both sides to
+  // cover every cell lineCollides() may read
+  void sweepLine(double wx0, double wy0, double wx1, double wy1);
+
+  // Restricts spans() to the cells [min_x, max_x) x [min_y, max_y), dropping the rows
+  // left empty, e.g. to only check the cells changed since a previous check
+  void clipSpans(int min_x, int min_y, int max_x, int max_y);
+
+  // Checks the cells of spans()
+  bool spansCollide() const;
+
+  // Walks the cells crossed by the segment centre line (DDA). With a pyramid, the walk
+  // starts over its coarsest level and only descends into the blocks that may collide
+  bool lineCollides(double wx0, double wy0, double wx1, double wy1) const;
+
+  // Checks the area swept by the footprint translated along the segment, facing its
+  // direction. The swept area is the convex hull of the footprint at both ends (the
+  // footprint hull for concave ones), rasterized once into cell spans which are then
+  // checked with a max scan of their grid rows, skipping the free pyramid blocks.
+  bool footprintCollides(
+    double wx0, double wy0, double wx1, double wy1,
+    const std::vector<geometry_msgs::msg::Point> & footprint);
+
+  // Spans of the last sweep, in grid cells
+  const std::vector<CellSpan> & spans() const {return spans_;}
+
+private:
+  struct Vec2
+  {
+    double x;
+    double y;
+  };
+
+  // Segment in grid coordinates, p(t) = origin + t * direction for t in [0, 1]
+  struct Ray
+  {
+    Vec2 origin;
+    Vec2 direction;
+  };
+
+  // Walks the cells of a level crossed by the ray for t in [t0, t1], which lies within
+  // the level cells [min, max] (the block of the level above)
+  bool walkCollides(
+    const Ray & ray, unsigned int level, double t0, double t1,
+    int min_x, int min_y, int max_x, int max_y) const;
+
+  bool cellCollides(unsigned int level, int x, int y) const;
+
+  // Footprint vertices at (wx, wy) facing yaw, into points_ in grid coordinates, pushed
+  // away from (wx, wy) by scale
+  void addFootprint(
+    double wx, double wy, double yaw, double scale,
+    const std::vector<geometry_msgs::msg::Point> & footprint);
+
+  // Convex hull of points_ in place, counter-clockwise (monotone chain)
+  void convexHull();
+
+  // Rows of cells touched by the convex polygon of points_, into spans_
+  void rasterize();
+
+  // Rows of cells touched by the convex hull, added to the rows of the polygons rasterized
+  // since the last clearRows()
+  void clearRows();
+  void addHullRows();
+
+  // One span per row of the rows added so far, into spans_
+  void rowsToSpans();
+
+  bool spanCollides(const CellSpan & span) const;
+
+  unsigned char cost_threshold_{253};
+  // Cost unknown cells are read as
+  unsigned char unknown_cost_{255};
+  bool allow_unknown_{true};
+
+  const unsigned char * costs_{nullptr};
+  unsigned int size_x_{0}, size_y_{0};
+  double resolution_{1.0}, origin_x_{0.0}, origin_y_{0.0};
+  const CostPyramid * pyramid_{nullptr};
+  const CostmapSnapshot * snapshot_{nullptr};
+
+  // Scratch storage reused between checks
+  std::vector<Vec2> points_;
+  std::vector<Vec2> hull_;
+  int first_row_{0};
+  std::vector<int> row_min_, row_max_;
+  std::vector<CellSpan> spans_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__SEGMENT_COLLISION_CHECKER_HPP_
@@ -41,18 +41,36 @@
 #ifndef NAV2_STRAIGHTLINE_PLANNER__STRAIGHT_LINE_PLANNER_HPP_
 #define NAV2_STRAIGHTLINE_PLANNER__STRAIGHT_LINE_PLANNER_HPP_
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #include "rclcpp/rclcpp.hpp"
 #include "geometry_msgs/msg/point.hpp"
 #include "geometry_msgs/msg/pose_stamped.hpp"
+#include "std_msgs/msg/float32_multi_array.hpp"
+#include "std_msgs/msg/float64.hpp"
 
 #include "nav2_core/global_planner.hpp"
+#include "nav_msgs/msg/occupancy_grid.hpp"
 #include "nav_msgs/msg/path.hpp"
 #include "nav2_util/robot_utils.hpp"
 #include "nav2_util/lifecycle_node.hpp"
 #include "nav2_costmap_2d/costmap_2d_ros.hpp"
+#include "nav2_straightline_planner/cost_pyramid.hpp"
+#include "nav2_straightline_planner/costmap_snapshot.hpp"
+#include "nav2_straightline_planner/free_cell_search.hpp"
+#include "nav2_straightline_planner/msg/compact_path.hpp"
+#include "nav2_straightline_planner/plan_recorder.hpp"
+#include "nav2_straightline_planner/segment_collision_checker.hpp"
+#include "nav2_straightline_planner/trapezoid_profile.hpp"
+#include "nav2_straightline_planner/updated_cells_layer.hpp"
+#include "nav2_straightline_planner/velocity_profile.hpp"
 
 namespace nav2_straightline_planner
 {
@@ -78,25 +96,226 @@ public:
   // plugin deactivate
   void deactivate() override;
 
-  // This method creates path for given start and goal pose.
+  // This method creates path for given start and goal pose. It is reentrant: concurrent
+  // requests only share the configuration, read-only once configured, and state guarded
+  // by the costmap mutex or their own mutexes
   nav_msgs::msg::Path createPlan(
     const geometry_msgs::msg::PoseStamped & start,
     const geometry_msgs::msg::PoseStamped & goal) override;
 
-private:
-  // TF buffer
-  std::shared_ptr<tf2_ros::Buffer> tf_;
+  // Creates the polyline path from start to goal through the via poses, in one path.
+  // Only the positions of the via poses are used. The request is added to the plan log
+  // if recording is enabled
+  nav_msgs::msg::Path createPlanThroughPoses(
+    const geometry_msgs::msg::PoseStamped & start,
+    const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+    const geometry_msgs::msg::PoseStamped & goal);
 
+protected:
   // node ptr
   nav2_util::LifecycleNode::SharedPtr node_;
 
-  // Global Costmap
-  nav2_costmap_2d::Costmap2D * costmap_;
-
   // The global frame of the costmap
   std::string global_frame_, name_;
 
+private:
+  // Costmap cells [min, max) changed since some point in time
+  struct DirtyArea
+  {
+    unsigned int min_x, min_y, max_x, max_y;
+
+    void reset()
+    {
+      min_x = min_y = std::numeric_limits<unsigned int>::max();
+      max_x = max_y = 0;
+    }
+
+    void add(unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1)
+    {
+      min_x = std::min(min_x, x0);
+      min_y = std::min(min_y, y0);
+      max_x = std::max(max_x, x1);
+      max_y = std::max(max_y, y1);
+    }
+
+    bool empty() const {return min_x >= max_x || min_y >= max_y;}
+  };
+
+  // Scratch storage of a plan request. Every thread has its own, so that concurrent
+  // requests never share it while the buffers are still reused between the requests of
+  // a thread
+  struct PlanScratch
+  {
+    std::vector<SegmentCollisionChecker> leg_checkers;
+    // Costmap cells under every leg, copied with the costmap locked
+    std::vector<CostmapSnapshot> leg_snapshots;
+    FreeCellSearch free_cell_search;
+    // Radius free_cell_search is configured for, -1 before the first relocation
+    int free_cell_search_radius{-1};
+    // Index of the first pose of every leg
+    std::vector<size_t> leg_starts;
+    // Speed limit annotation of the path poses and route ETA
+    std::vector<float> speed_limits;
+    VelocityProfile velocity_profile;
+    // Checksum of the costmap cells checked by the last request, for the plan log
+    uint32_t costmap_checksum{0};
+  };
+
+  // Scratch storage of the calling thread
+  static PlanScratch & planScratch();
+
+  // Plans createPlanThroughPoses() requests
+  nav_msgs::msg::Path planThroughPoses(
+    const geometry_msgs::msg::PoseStamped & start,
+    const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+    const geometry_msgs::msg::PoseStamped & goal);
+
+  // Returns the part of the previous path still ahead of the start in global_path, if the
+  // request has the same goal and via points and the start is close to the previous path.
+  // Returns false when the plan has to be made from scratch
+  bool reusePreviousPlan(
+    const geometry_msgs::msg::PoseStamped & start,
+    const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+    const geometry_msgs::msg::PoseStamped & goal,
+    nav_msgs::msg::Path & global_path);
+
+  // Checks the polyline against the costmap cells changed since the previous plan only,
+  // with the costmap locked. These are the only cells of a part of the previous polyline
+  // that may have become blocking. Also true when the changes since the previous plan are
+  // unknown, i.e. when another plan was checked since or the costmap has moved.
+  // Called with previous_plan_mutex_ locked
+  bool changedCellsCollide(
+    const std::vector<geometry_msgs::msg::Point> & corners, double start_yaw);
+
+  // Stores a plan for reuse, unless another plan was checked after it
+  void storePreviousPlan(
+    const nav_msgs::msg::Path & global_path,
+    const std::vector<size_t> & leg_starts,
+    const std::vector<geometry_msgs::msg::Point> & corners,
+    const geometry_msgs::msg::PoseStamped & goal,
+    const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+    uint64_t plan_generation);
+
+  // Publishes the polyline a path was interpolated from, its first skipped_poses poses
+  // dropped and the next one moved to start
+  void publishCompactPath(
+    const std::vector<geometry_msgs::msg::Point> & corners,
+    const geometry_msgs::msg::Quaternion & goal_orientation,
+    size_t skipped_poses, const geometry_msgs::msg::Point & start,
+    const rclcpp::Time & plan_time);
+
+  // Checks every leg of the polyline against the global costmap, with the robot footprint
+  // if enabled, turning in place from start_yaw at the start and between legs at the corners.
+  // The legs are checked in the calling thread, each on its own costmap snapshot.
+  // plan_generation identifies the costmap state the polyline was checked against
+  bool polylineCollides(
+    const std::vector<geometry_msgs::msg::Point> & corners, double start_yaw,
+    uint64_t & plan_generation);
+
+  // Sweeps the footprint, or the centre line without one, along a leg of the polyline,
+  // turning in place at its start from the heading of the last leg of non-zero length
+  // before, start_yaw for the first one. Returns the heading at the end of the leg
+  double sweepLeg(
+    SegmentCollisionChecker & checker, const std::vector<geometry_msgs::msg::Point> & corners,
+    size_t leg, double start_yaw, const std::vector<geometry_msgs::msg::Point> & footprint) const;
+
+  // Moves the pose to the closest cell free for the robot centre if it is not on one.
+  // Returns false if there is none within relocation_max_distance
+  bool relocate(geometry_msgs::msg::PoseStamped & pose, const char * pose_name);
+
+  // Brings the pyramid up to date with the costmap. Called with the costmap locked and
+  // pyramid_mutex_ locked exclusively
+  void updatePyramid();
+
+  // Stores the latest speed filter mask
+  void speedMaskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg);
+
+  // Returns the speed limit [m/s] of the speed mask cell under given world point
+  double getSpeedLimit(const nav_msgs::msg::OccupancyGrid & mask, double wx, double wy) const;
+
+  // TF buffer
+  std::shared_ptr<tf2_ros::Buffer> tf_;
+
+  // Global Costmap
+  std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros_;
+  nav2_costmap_2d::Costmap2D * costmap_;
+
   double interpolation_resolution_;
+  // Poses face the direction of their leg instead of the identity orientation
+  bool use_leg_headings_;
+
+  // Collision checking of the segment before the path is generated
+  bool collision_checking_;
+  bool use_footprint_;
+  bool allow_unknown_;
+  unsigned char collision_cost_threshold_;
+
+  // Relocation of a start or goal lying in a lethal or inflated cell
+  bool relocate_start_;
+  bool relocate_goal_;
+  int relocation_radius_;
+
+  // Max-pooled pyramid of the costmap letting the collision checks skip free blocks.
+  // It is rebuilt lazily before a check, over the cells changed since the previous one,
+  // and fully when the costmap moves or is resized. The changed cells are reported by
+  // updated_cells_layer_ on every costmap update, to plan_dirty_ as well
+  bool use_cost_pyramid_;
+  CostPyramid cost_pyramid_;
+  // Held shared by the checks reading the pyramid and exclusively to update it, which is
+  // only tried with the costmap locked
+  std::shared_timed_mutex pyramid_mutex_;
+  std::shared_ptr<UpdatedCellsLayer> updated_cells_layer_;
+  double pyramid_origin_x_, pyramid_origin_y_;
+  // Costmap cells changed since the pyramid was updated, guarded by the costmap mutex
+  DirtyArea pyramid_dirty_;
+
+  // Limits of the speed profiles. In a timed path the pose stamps are the planned time
+  // of arrival at every pose instead of the planning time
+  double max_velocity_, max_acceleration_;
+  bool timed_path_;
+
+  // Previous plan, reused while the goal is unchanged: its path, the first pose of every
+  // leg and the request it was made for, guarded by previous_plan_mutex_
+  bool reuse_previous_plan_;
+  double reuse_max_deviation_;
+  std::mutex previous_plan_mutex_;
+  nav_msgs::msg::Path previous_path_;
+  std::vector<size_t> previous_leg_starts_;
+  std::vector<geometry_msgs::msg::Point> previous_corners_;
+  geometry_msgs::msg::PoseStamped previous_goal_;
+  std::vector<geometry_msgs::msg::PoseStamped> previous_via_poses_;
+  uint64_t previous_generation_;
+  // Projection of the last start on the previous path, segment after the closest pose and
+  // position along it; later starts have to be ahead of it
+  size_t previous_index_;
+  double previous_fraction_;
+  // Costmap cells changed since the last plan was checked, the number of checked plans and
+  // the costmap origin at the last check, guarded by the costmap mutex
+  DirtyArea plan_dirty_;
+  uint64_t plan_generation_{0};
+  double plan_origin_x_, plan_origin_y_;
+
+  // Log of the plan requests, for offline replay; nullptr unless record_file is set
+  std::unique_ptr<PlanRecorder> plan_recorder_;
+
+  // Speed filter mask sampling, see nav2_costmap_filters_demo/params/speed_params.yaml
+  bool use_speed_mask_;
+  std::string speed_mask_topic_;
+  double speed_mask_base_, speed_mask_multiplier_;
+  bool speed_limit_in_percent_;
+
+  rclcpp::Subscription<nav_msgs::msg::OccupancyGrid>::SharedPtr speed_mask_sub_;
+  nav_msgs::msg::OccupancyGrid::SharedPtr speed_mask_;
+  std::mutex speed_mask_mutex_;
+
+  // Speed limit annotation of the path poses and route ETA
+  rclcpp_lifecycle::LifecyclePublisher<std_msgs::msg::Float32MultiArray>::SharedPtr
+    speed_limits_pub_;
+  rclcpp_lifecycle::LifecyclePublisher<std_msgs::msg::Float64>::SharedPtr eta_pub_;
+
+  // Compact encoding of every plan, see msg/CompactPath.msg; nullptr unless
+  // publish_compact_path is set
+  rclcpp_lifecycle::LifecyclePublisher<msg::CompactPath>::SharedPtr compact_path_pub_;
 };
 
 }  // namespace nav2_straightline_planner
@@ -0,0 +1,103 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__STRAIGHT_LINE_VIA_POINTS_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__STRAIGHT_LINE_VIA_POINTS_HPP_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nav_msgs/msg/path.hpp"
+#include "nav2_straightline_planner/straight_line_planner.hpp"
+
+namespace nav2_straightline_planner
+{
+
+// StraightLine variant planning through via points, so that a "go via A, B, C" route is
+// one planner request and one navigation goal. The via points are the poses of the
+// latest path received on <name>/via_points (latched), an empty path clearing them.
+// They are bound to the goal of the first request after they are received and dropped
+// on a request for another goal. Replans of that goal only go through the via points not
+// reached yet: within via_point_tolerance of the start, or passed by it.
+// Poses face the direction of their leg unless use_leg_headings is set to false.
+class StraightLineViaPoints : public StraightLine
+{
+public:
+  StraightLineViaPoints() = default;
+  ~StraightLineViaPoints() = default;
+
+  // plugin configure
+  void configure(
+    const rclcpp_lifecycle::LifecycleNode::WeakPtr & parent,
+    std::string name, std::shared_ptr<tf2_ros::Buffer> tf,
+    std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros) override;
+
+  // plugin cleanup
+  void cleanup() override;
+
+  // This method creates path for given start and goal pose through the via points.
+  nav_msgs::msg::Path createPlan(
+    const geometry_msgs::msg::PoseStamped & start,
+    const geometry_msgs::msg::PoseStamped & goal) override;
+
+private:
+  // Stores the via points of the latest path
+  void viaPointsCallback(const nav_msgs::msg::Path::SharedPtr msg);
+
+  // Drops the via points reached by the start, or all of them if the goal is not the one
+  // they are bound to. Called with via_poses_mutex_ locked
+  void consumeViaPoints(
+    const geometry_msgs::msg::PoseStamped & start,
+    const geometry_msgs::msg::PoseStamped & goal);
+
+  double via_point_tolerance_;
+
+  rclcpp::Subscription<nav_msgs::msg::Path>::SharedPtr via_points_sub_;
+  // Via points not reached yet, in order
+  std::vector<geometry_msgs::msg::PoseStamped> via_poses_;
+  // Goal the via points are bound to, unset until the first request after they arrived
+  bool via_goal_set_{false};
+  geometry_msgs::msg::PoseStamped via_goal_;
+  // Start of the leg to the first via point: the start of the first request, then the
+  // last reached via point
+  geometry_msgs::msg::Point leg_from_;
+  std::mutex via_poses_mutex_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__STRAIGHT_LINE_VIA_POINTS_HPP_
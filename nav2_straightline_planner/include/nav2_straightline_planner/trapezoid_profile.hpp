@@ -0,0 +1,115 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__TRAPEZOID_PROFILE_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__TRAPEZOID_PROFILE_HPP_
+
+#include <algorithm>
+#include <cmath>
+
+namespace nav2_straightline_planner
+{
+
+// Closed-form trapezoidal speed profile over a straight segment of given length,
+// starting and ending at rest: accelerate at max_acceleration up to max_velocity,
+// cruise, then decelerate. Short segments never reach max_velocity and get a
+// triangular profile. A non-positive max_acceleration means constant max_velocity.
+// Header-only, so that compact path consumers can time the poses the same way.
+class TrapezoidProfile
+{
+public:
+  TrapezoidProfile() = default;
+
+  // Computes the profile phases of a segment of given length [m]
+  void configure(double length, double max_velocity, double max_acceleration)
+  {
+    length_ = std::max(length, 0.0);
+    velocity_ = max_velocity;
+    acceleration_ = max_acceleration;
+    if (length_ == 0.0) {
+      ramp_length_ = ramp_time_ = duration_ = 0.0;
+      return;
+    }
+    if (acceleration_ <= 0.0) {
+      ramp_length_ = ramp_time_ = 0.0;
+      duration_ = length_ / velocity_;
+      return;
+    }
+
+    ramp_length_ = velocity_ * velocity_ / (2.0 * acceleration_);
+    if (2.0 * ramp_length_ > length_) {
+      // Triangular profile, peaking halfway at sqrt(a * L)
+      ramp_length_ = length_ / 2.0;
+      velocity_ = std::sqrt(acceleration_ * length_);
+    }
+    ramp_time_ = velocity_ / acceleration_;
+    duration_ = 2.0 * ramp_time_ + (length_ - 2.0 * ramp_length_) / velocity_;
+  }
+
+  // Travel time over the whole segment [s]
+  double duration() const {return duration_;}
+
+  // Time to reach distance s [m] from the segment start [s], in O(1)
+  double timeAt(double s) const
+  {
+    s = std::min(std::max(s, 0.0), length_);
+    if (length_ == 0.0) {
+      return 0.0;
+    }
+    if (acceleration_ <= 0.0) {
+      return s / velocity_;
+    }
+    if (s < ramp_length_) {
+      return std::sqrt(2.0 * s / acceleration_);
+    }
+    if (s > length_ - ramp_length_) {
+      return duration_ - std::sqrt(2.0 * (length_ - s) / acceleration_);
+    }
+    return ramp_time_ + (s - ramp_length_) / velocity_;
+  }
+
+private:
+  double length_{0.0};
+  double velocity_{0.0};
+  double acceleration_{0.0};
+  // Length and duration of the acceleration (and deceleration) phase
+  double ramp_length_{0.0};
+  double ramp_time_{0.0};
+  double duration_{0.0};
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__TRAPEZOID_PROFILE_HPP_
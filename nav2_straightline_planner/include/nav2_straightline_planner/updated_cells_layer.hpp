@@ -0,0 +1,92 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__UPDATED_CELLS_LAYER_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__UPDATED_CELLS_LAYER_HPP_
+
+#include <functional>
+#include <memory>
+
+#include "nav2_costmap_2d/costmap_2d.hpp"
+#include "nav2_costmap_2d/layer.hpp"
+#include "nav2_costmap_2d/layered_costmap.hpp"
+
+namespace nav2_straightline_planner
+{
+
+// Costmap layer reporting the cells rewritten by every update of the costmap. It writes
+// no cost: the layered costmap calls updateCosts() of every layer with the window of
+// cells it updated in that cycle, so appending this layer to it hooks every update,
+// however many happen between two plans. LayeredCostmap::getUpdatedBounds() only holds
+// the window of the latest one.
+class UpdatedCellsLayer : public nav2_costmap_2d::Layer
+{
+public:
+  // Called with the costmap locked, with the updated cells [min_x, max_x) x [min_y, max_y)
+  using Callback =
+    std::function<void(unsigned int, unsigned int, unsigned int, unsigned int)>;
+
+  // Appends a layer calling callback to the layered costmap
+  static std::shared_ptr<UpdatedCellsLayer> attach(
+    nav2_costmap_2d::LayeredCostmap * layered_costmap, Callback callback);
+
+  // Removes the layer from the layered costmap it was attached to, if that is still
+  // layered_costmap: a costmap cleaned up first has already released its layers
+  void detach(nav2_costmap_2d::LayeredCostmap * layered_costmap);
+
+  // Reports the whole costmap, which is cleared
+  void reset() override;
+
+  bool isClearable() override {return false;}
+
+  void updateBounds(double, double, double, double *, double *, double *, double *) override {}
+
+  // Reports the updated window
+  void updateCosts(
+    nav2_costmap_2d::Costmap2D & master_grid,
+    int min_i, int min_j, int max_i, int max_j) override;
+
+  // Reports the whole costmap, which is resized
+  void matchSize() override;
+
+private:
+  UpdatedCellsLayer(nav2_costmap_2d::LayeredCostmap * layered_costmap, Callback callback);
+
+  Callback callback_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__UPDATED_CELLS_LAYER_HPP_
@@ -0,0 +1,89 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#ifndef NAV2_STRAIGHTLINE_PLANNER__VELOCITY_PROFILE_HPP_
+#define NAV2_STRAIGHTLINE_PLANNER__VELOCITY_PROFILE_HPP_
+
+#include <vector>
+
+namespace nav2_straightline_planner
+{
+
+// Converts a speed filter mask value into a speed limit in m/s, following the
+// nav2_costmap_2d::SpeedFilter conventions: unknown (-1) and 0 mean "no limit",
+// every other value is mapped through base + multiplier * value, either as
+// a percentage of max_velocity or as an absolute speed. Limits that are not
+// positive, or above 100%, also mean "no limit".
+double speedLimitFromMask(
+  signed char mask_value, double base, double multiplier,
+  bool in_percent, double max_velocity);
+
+// Time-optimal speed profile along a sampled path with per-sample speed caps.
+// The profile starts and ends at rest and never exceeds max_acceleration
+// (a non-positive max_acceleration disables the acceleration limit).
+// The forward (acceleration) pass is done incrementally through addSample()
+// so it can be driven from the same loop that generates the path poses;
+// finalize() runs the backward (deceleration) pass and integrates the time.
+class VelocityProfile
+{
+public:
+  VelocityProfile() = default;
+
+  // Clears the samples keeping the allocated storage
+  void reset(double max_acceleration);
+
+  // Appends a sample at distance ds [m] from the previous one with speed cap [m/s]
+  void addSample(double ds, double speed_cap);
+
+  // Runs the backward pass and returns the total travel time [s].
+  // Returns +inf if some part of the path has a zero speed limit.
+  double finalize();
+
+  // Reachable speed at every sample [m/s]; valid after finalize()
+  const std::vector<double> & velocities() const {return velocities_;}
+
+  // Time from path start to every sample [s]; valid after finalize()
+  const std::vector<double> & times() const {return times_;}
+
+private:
+  double max_acceleration_{0.0};
+  std::vector<double> distances_;
+  std::vector<double> velocities_;
+  std::vector<double> times_;
+};
+
+}  // namespace nav2_straightline_planner
+
+#endif  // NAV2_STRAIGHTLINE_PLANNER__VELOCITY_PROFILE_HPP_
@@ -0,0 +1,135 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_straightline_planner/cost_pyramid.hpp"
+
+namespace nav2_straightline_planner
+{
+
+constexpr unsigned int CostPyramid::BLOCK_SIZE;
+
+void CostPyramid::configure(unsigned int levels, unsigned char unknown_cost)
+{
+  unknown_cost_ = unknown_cost;
+  built_ = false;
+  levels_.resize(levels);
+  block_sizes_.resize(levels + 1);
+  block_sizes_[0] = 1;
+  for (unsigned int l = 1; l <= levels; ++l) {
+    block_sizes_[l] = block_sizes_[l - 1] * BLOCK_SIZE;
+  }
+}
+
+void CostPyramid::rebuild(const unsigned char * costs, unsigned int size_x, unsigned int size_y)
+{
+  grid_size_x_ = size_x;
+  grid_size_y_ = size_y;
+  unsigned int below_x = size_x, below_y = size_y;
+  for (unsigned int l = 1; l <= levels_.size(); ++l) {
+    Level & level = levels_[l - 1];
+    level.size_x = (below_x + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    level.size_y = (below_y + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    level.costs.resize(static_cast<size_t>(level.size_x) * level.size_y);
+    pool(l, costs, 0, 0, level.size_x, level.size_y);
+    below_x = level.size_x;
+    below_y = level.size_y;
+  }
+  built_ = true;
+}
+
+void CostPyramid::update(
+  const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+  unsigned int min_x, unsigned int min_y, unsigned int max_x, unsigned int max_y)
+{
+  if (!built_ || size_x != grid_size_x_ || size_y != grid_size_y_) {
+    rebuild(costs, size_x, size_y);
+    return;
+  }
+
+  max_x = std::min(max_x, size_x);
+  max_y = std::min(max_y, size_y);
+  for (unsigned int l = 1; l <= levels_.size() && min_x < max_x && min_y < max_y; ++l) {
+    // Blocks of this level overlapping the updated cells of the level below
+    min_x /= BLOCK_SIZE;
+    min_y /= BLOCK_SIZE;
+    max_x = (max_x + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    max_y = (max_y + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    pool(l, costs, min_x, min_y, max_x, max_y);
+  }
+}
+
+void CostPyramid::pool(
+  unsigned int level, const unsigned char * costs,
+  unsigned int min_x, unsigned int min_y, unsigned int max_x, unsigned int max_y)
+{
+  Level & out = levels_[level - 1];
+  const unsigned char * in = level == 1 ? costs : levels_[level - 2].costs.data();
+  const unsigned int in_size_x = level == 1 ? grid_size_x_ : levels_[level - 2].size_x;
+  const unsigned int in_size_y = level == 1 ? grid_size_y_ : levels_[level - 2].size_y;
+  // Unknown cells only exist in the grid, pooled levels already hold unknown_cost
+  const unsigned char unknown = level == 1 ? unknown_cost_ : nav2_costmap_2d::NO_INFORMATION;
+
+  for (unsigned int y = min_y; y < max_y; ++y) {
+    unsigned char * out_row = &out.costs[static_cast<size_t>(y) * out.size_x];
+    std::fill(out_row + min_x, out_row + max_x, 0);
+    const unsigned int in_max_y = std::min((y + 1) * BLOCK_SIZE, in_size_y);
+    for (unsigned int in_y = y * BLOCK_SIZE; in_y < in_max_y; ++in_y) {
+      const unsigned char * in_row = in + static_cast<size_t>(in_y) * in_size_x;
+      for (unsigned int x = min_x; x < max_x; ++x) {
+        const unsigned int in_max_x = std::min((x + 1) * BLOCK_SIZE, in_size_x);
+        unsigned char block_max = out_row[x];
+        for (unsigned int in_x = x * BLOCK_SIZE; in_x < in_max_x; ++in_x) {
+          const unsigned char cost =
+            in_row[in_x] == nav2_costmap_2d::NO_INFORMATION ? unknown : in_row[in_x];
+          block_max = std::max(block_max, cost);
+        }
+        out_row[x] = block_max;
+      }
+    }
+
+    // Cells past the grid edges are unknown
+    for (unsigned int x = min_x; x < max_x; ++x) {
+      if (in_max_y < (y + 1) * BLOCK_SIZE || in_size_x < (x + 1) * BLOCK_SIZE) {
+        out_row[x] = std::max(out_row[x], unknown_cost_);
+      }
+    }
+  }
+}
+
+}  // namespace nav2_straightline_planner
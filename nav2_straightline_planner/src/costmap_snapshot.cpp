@@ -0,0 +1,105 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "nav2_straightline_planner/costmap_snapshot.hpp"
+
+namespace nav2_straightline_planner
+{
+
+void CostmapSnapshot::capture(
+  const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+  const std::vector<CellSpan> & spans)
+{
+  rows_.clear();
+  costs_.clear();
+  if (spans.empty()) {
+    return;
+  }
+
+  first_row_ = spans.front().row;
+  rows_.resize(spans.back().row - first_row_ + 1, Row{0, -1, 0});
+  size_t size = 0;
+  for (const auto & span : spans) {
+    Row & row = rows_[span.row - first_row_];
+    if (span.row < 0 || span.row >= static_cast<int>(size_y)) {
+      continue;
+    }
+    row.min_x = std::max(span.min_x, 0);
+    row.max_x = std::min(span.max_x, static_cast<int>(size_x) - 1);
+    row.offset = size;
+    size += std::max(row.max_x - row.min_x + 1, 0);
+  }
+
+  costs_.resize(size);
+  for (size_t r = 0; r < rows_.size(); ++r) {
+    const Row & row = rows_[r];
+    if (row.min_x <= row.max_x) {
+      std::memcpy(
+        costs_.data() + row.offset,
+        costs + static_cast<size_t>(first_row_ + r) * size_x + row.min_x,
+        row.max_x - row.min_x + 1);
+    }
+  }
+}
+
+uint32_t CostmapSnapshot::checksum() const
+{
+  uint32_t hash = 2166136261u;
+  auto add = [&hash](uint32_t byte) {
+      hash = (hash ^ byte) * 16777619u;
+    };
+  for (size_t r = 0; r < rows_.size(); ++r) {
+    const Row & row = rows_[r];
+    if (row.min_x > row.max_x) {
+      continue;
+    }
+    for (int v : {first_row_ + static_cast<int>(r), row.min_x, row.max_x}) {
+      for (int shift = 0; shift < 32; shift += 8) {
+        add((static_cast<uint32_t>(v) >> shift) & 0xff);
+      }
+    }
+    const unsigned char * cost = costs_.data() + row.offset;
+    for (int x = row.min_x; x <= row.max_x; ++x) {
+      add(*cost++);
+    }
+  }
+  return hash;
+}
+
+}  // namespace nav2_straightline_planner
@@ -0,0 +1,130 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_straightline_planner/free_cell_search.hpp"
+
+namespace nav2_straightline_planner
+{
+
+void FreeCellSearch::configure(unsigned int max_radius)
+{
+  max_radius_ = max_radius;
+  window_size_ = 2 * max_radius_ + 1;
+  const size_t cells = static_cast<size_t>(window_size_) * window_size_;
+  visited_.assign(cells, 0);
+  queue_.resize(cells);
+  epoch_ = 0;
+}
+
+bool FreeCellSearch::find(
+  const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+  unsigned int x, unsigned int y, unsigned char cost_threshold, bool allow_unknown,
+  unsigned int & free_x, unsigned int & free_y)
+{
+  if (++epoch_ == 0) {
+    // Stamps wrapped around, older ones could be taken as current
+    std::fill(visited_.begin(), visited_.end(), 0);
+    epoch_ = 1;
+  }
+
+  // Window in grid cells, clipped to the grid
+  const int origin_x = static_cast<int>(x) - max_radius_;
+  const int origin_y = static_cast<int>(y) - max_radius_;
+  const int min_x = std::max(origin_x, 0);
+  const int min_y = std::max(origin_y, 0);
+  const int max_x = std::min(origin_x + window_size_, static_cast<int>(size_x)) - 1;
+  const int max_y = std::min(origin_y + window_size_, static_cast<int>(size_y)) - 1;
+
+  auto is_free = [&](int cx, int cy) {
+      const unsigned char cost = costs[static_cast<size_t>(cy) * size_x + cx];
+      return cost == nav2_costmap_2d::NO_INFORMATION ? allow_unknown : cost < cost_threshold;
+    };
+
+  // 8-connected layers hold the cells at a given chebyshev distance. Once a free cell is
+  // found at distance d, closer ones in euclidean distance can still be up to d * sqrt(2)
+  // layers away
+  size_t head = 0, tail = 0;
+  const uint32_t start = max_radius_ * window_size_ + max_radius_;
+  visited_[start] = epoch_;
+  queue_[tail++] = start;
+  // The window corners are up to max_radius * sqrt(2) away, out of the search radius
+  const int max_distance_sq = max_radius_ * max_radius_;
+  int best_distance_sq = std::numeric_limits<int>::max();
+  int last_layer = max_radius_;
+  for (int layer = 0; layer <= last_layer && head < tail; ++layer) {
+    for (size_t layer_end = tail; head < layer_end; ++head) {
+      const int wx = queue_[head] % window_size_;
+      const int wy = queue_[head] / window_size_;
+      const int cx = origin_x + wx;
+      const int cy = origin_y + wy;
+      if (is_free(cx, cy)) {
+        const int distance_sq = (wx - max_radius_) * (wx - max_radius_) +
+          (wy - max_radius_) * (wy - max_radius_);
+        if (distance_sq <= max_distance_sq && distance_sq < best_distance_sq) {
+          best_distance_sq = distance_sq;
+          free_x = cx;
+          free_y = cy;
+          last_layer = std::min(
+            last_layer, static_cast<int>(std::floor(layer * std::sqrt(2.0))));
+        }
+      }
+
+      for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+          const int nx = cx + dx;
+          const int ny = cy + dy;
+          if (nx < min_x || ny < min_y || nx > max_x || ny > max_y) {
+            continue;
+          }
+          const uint32_t index = (wy + dy) * window_size_ + wx + dx;
+          if (visited_[index] != epoch_) {
+            visited_[index] = epoch_;
+            queue_[tail++] = index;
+          }
+        }
+      }
+    }
+  }
+  return best_distance_sq != std::numeric_limits<int>::max();
+}
+
+}  // namespace nav2_straightline_planner
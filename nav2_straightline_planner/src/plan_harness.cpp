@@ -0,0 +1,123 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "geometry_msgs/msg/transform_stamped.hpp"
+#include "nav2_straightline_planner/plan_harness.hpp"
+
+namespace nav2_straightline_planner
+{
+
+PlanHarness::PlanHarness(
+  const std::string & node_name, const std::string & plugin_name,
+  const rclcpp::NodeOptions & options)
+: node_(std::make_shared<nav2_util::LifecycleNode>(node_name, "", options)),
+  loader_("nav2_core", "nav2_core::GlobalPlanner")
+{
+  node_->declare_parameter(
+    "planner_plugin", rclcpp::ParameterValue("nav2_straightline_planner/StraightLine"));
+  const std::string planner_plugin = node_->get_parameter("planner_plugin").as_string();
+
+  // The costmap spins its own executor; the robot is pinned to the global frame origin
+  costmap_ros_ = std::make_shared<nav2_costmap_2d::Costmap2DROS>(
+    "global_costmap", std::string{node_->get_namespace()}, "global_costmap");
+  costmap_ros_->configure();
+  tf_broadcaster_ = std::make_unique<tf2_ros::StaticTransformBroadcaster>(node_);
+  geometry_msgs::msg::TransformStamped robot_transform;
+  robot_transform.header.stamp = node_->now();
+  robot_transform.header.frame_id = costmap_ros_->getGlobalFrameID();
+  robot_transform.child_frame_id = costmap_ros_->getBaseFrameID();
+  robot_transform.transform.rotation.w = 1.0;
+  tf_broadcaster_->sendTransform(robot_transform);
+  costmap_ros_->activate();
+  const auto costmap_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!costmap_ros_->isCurrent() && std::chrono::steady_clock::now() < costmap_deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  costmap_ros_->pause();
+
+  try {
+    planner_ = loader_.createSharedInstance(planner_plugin);
+  } catch (pluginlib::PluginlibException & e) {
+    costmap_ros_->deactivate();
+    costmap_ros_->cleanup();
+    throw std::runtime_error("Failed to load " + planner_plugin + ": " + e.what());
+  }
+  auto tf = std::make_shared<tf2_ros::Buffer>(node_->get_clock());
+  planner_->configure(node_, plugin_name, tf, costmap_ros_);
+  planner_->activate();
+
+  executor_.add_node(node_->get_node_base_interface());
+  spin_thread_ = std::thread([this]() {executor_.spin();});
+  active_ = true;
+}
+
+PlanHarness::~PlanHarness()
+{
+  shutdown();
+}
+
+void PlanHarness::shutdown()
+{
+  if (!active_) {
+    return;
+  }
+  active_ = false;
+  executor_.cancel();
+  spin_thread_.join();
+  planner_->deactivate();
+  planner_->cleanup();
+  costmap_ros_->deactivate();
+  costmap_ros_->cleanup();
+}
+
+double percentileMs(std::vector<int64_t> & durations_ns, double percentile)
+{
+  if (durations_ns.empty()) {
+    return 0.0;
+  }
+  const size_t index = static_cast<size_t>(percentile / 100.0 * (durations_ns.size() - 1));
+  std::nth_element(durations_ns.begin(), durations_ns.begin() + index, durations_ns.end());
+  return durations_ns[index] * 1e-6;
+}
+
+}  // namespace nav2_straightline_planner
@@ -0,0 +1,182 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "nav2_straightline_planner/plan_recorder.hpp"
+
+namespace nav2_straightline_planner
+{
+
+PlanLog readPlanLog(const std::string & filename)
+{
+  FILE * file = std::fopen(filename.c_str(), "rb");
+  if (!file) {
+    throw std::runtime_error("Failed to open plan log " + filename);
+  }
+  PlanLog plan_log;
+  char magic[sizeof(PLAN_LOG_MAGIC) - 1];
+  if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+    std::memcmp(magic, PLAN_LOG_MAGIC, sizeof(magic)) != 0 ||
+    std::fread(&plan_log.dropped, sizeof(plan_log.dropped), 1, file) != 1)
+  {
+    std::fclose(file);
+    throw std::runtime_error(filename + " is not a plan log");
+  }
+
+  PlanRecord plan_record;
+  while (std::fread(&plan_record, sizeof(plan_record), 1, file) == 1) {
+    plan_log.records.push_back(plan_record);
+  }
+  std::fclose(file);
+  return plan_log;
+}
+
+PlanRecorder::PlanRecorder(const std::string & filename, size_t capacity)
+{
+  size_t size = 1;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  slots_.reset(new Slot[size]);
+  for (size_t i = 0; i < size; ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  mask_ = size - 1;
+
+  file_ = std::fopen(filename.c_str(), "wb");
+  if (!file_) {
+    throw std::runtime_error("Failed to create plan log " + filename);
+  }
+  const uint64_t dropped = 0;
+  std::fwrite(PLAN_LOG_MAGIC, 1, sizeof(PLAN_LOG_MAGIC) - 1, file_);
+  std::fwrite(&dropped, sizeof(dropped), 1, file_);
+  writer_ = std::thread(&PlanRecorder::writerLoop, this);
+}
+
+PlanRecorder::~PlanRecorder()
+{
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  writer_.join();
+
+  const uint64_t dropped = dropped_.load();
+  if (dropped > 0 && std::fseek(file_, sizeof(PLAN_LOG_MAGIC) - 1, SEEK_SET) == 0) {
+    std::fwrite(&dropped, sizeof(dropped), 1, file_);
+  }
+  std::fclose(file_);
+}
+
+bool PlanRecorder::record(const PlanRecord & plan_record)
+{
+  size_t position = enqueue_position_.load(std::memory_order_relaxed);
+  Slot * slot;
+  while (true) {
+    slot = &slots_[position & mask_];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+    if (lag == 0) {
+      if (enqueue_position_.compare_exchange_weak(
+          position, position + 1, std::memory_order_relaxed))
+      {
+        break;
+      }
+    } else if (lag < 0) {
+      // The slot still holds the record of the previous lap
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      pending_drops_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      position = enqueue_position_.load(std::memory_order_relaxed);
+    }
+  }
+  slot->record = plan_record;
+  // Drops racing with this record may be attached to the next one, the total is exact
+  slot->record.dropped_before = pending_drops_.exchange(0, std::memory_order_relaxed);
+  slot->sequence.store(position + 1, std::memory_order_release);
+  // Without the mutex a wakeup may be missed, the writer then drains on its next timeout
+  wake_.notify_one();
+  return true;
+}
+
+bool PlanRecorder::take(PlanRecord & plan_record)
+{
+  Slot & slot = slots_[dequeue_position_ & mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) {
+    return false;
+  }
+  plan_record = slot.record;
+  slot.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+  ++dequeue_position_;
+  return true;
+}
+
+void PlanRecorder::writerLoop()
+{
+  PlanRecord plan_record;
+  while (true) {
+    bool written = false;
+    while (take(plan_record)) {
+      std::fwrite(&plan_record, sizeof(plan_record), 1, file_);
+      written = true;
+    }
+    if (written) {
+      std::fflush(file_);
+    }
+
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    if (stop_) {
+      break;
+    }
+    wake_.wait_for(lock, std::chrono::milliseconds(100));
+  }
+
+  // Records queued before the recorder was stopped
+  while (take(plan_record)) {
+    std::fwrite(&plan_record, sizeof(plan_record), 1, file_);
+  }
+  std::fflush(file_);
+}
+
+}  // namespace nav2_straightline_planner
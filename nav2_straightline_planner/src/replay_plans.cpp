@@ -0,0 +1,205 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Replays a plan log recorded by the StraightLine record_file parameter through a planner
+// plugin in a tight loop, for profiling and regression comparison:
+//   replay_plans <plan_log> [repeat] --ros-args --params-file <params.yaml>
+// The global_costmap and the "replay" planner plugin are configured from the parameters,
+// usually a static map standing for the production costmap. The replayed requests are
+// logged to <plan_log>.replay and compared with the recorded ones: planning times,
+// returned path sizes and checksums of the checked costmap cells, which only match when
+// the replay costmap holds the same cells as in production.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "nav2_straightline_planner/plan_harness.hpp"
+#include "nav2_straightline_planner/plan_recorder.hpp"
+
+namespace
+{
+
+geometry_msgs::msg::PoseStamped toPose(
+  double x, double y, double qz, double qw, const std::string & frame)
+{
+  geometry_msgs::msg::PoseStamped pose;
+  pose.header.frame_id = frame;
+  pose.pose.position.x = x;
+  pose.pose.position.y = y;
+  pose.pose.orientation.z = qz;
+  pose.pose.orientation.w = qw;
+  return pose;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  const auto args = rclcpp::remove_ros_arguments(argc, argv);
+  if (args.size() < 2 || args.size() > 3) {
+    std::fprintf(
+      stderr, "Usage: %s <plan_log> [repeat] --ros-args --params-file <params.yaml>\n",
+      args[0].c_str());
+    return 1;
+  }
+  const std::string log_filename = args[1];
+  const std::string replay_filename = log_filename + ".replay";
+  const int repeat = args.size() == 3 ? std::max(std::atoi(args[2].c_str()), 1) : 1;
+
+  nav2_straightline_planner::PlanLog plan_log;
+  try {
+    plan_log = nav2_straightline_planner::readPlanLog(log_filename);
+  } catch (std::exception & e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  const auto & records = plan_log.records;
+
+  // The requests are replayed faster than in production; a queue holding a whole pass
+  // keeps the replay log from dropping them
+  std::unique_ptr<nav2_straightline_planner::PlanHarness> harness;
+  try {
+    harness = std::make_unique<nav2_straightline_planner::PlanHarness>(
+      "plan_replay", "replay",
+      rclcpp::NodeOptions()
+      .append_parameter_override("replay.record_file", replay_filename)
+      .append_parameter_override(
+        "replay.record_queue_size",
+        static_cast<int>(std::min<size_t>(std::max<size_t>(records.size(), 1024), 1 << 20))));
+  } catch (std::exception & e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  nav2_core::GlobalPlanner & planner = harness->planner();
+
+  // Via points are not logged, so those requests can't be replayed
+  std::vector<size_t> replayed;
+  for (size_t i = 0; i < records.size(); ++i) {
+    if (records[i].via_points == 0) {
+      replayed.push_back(i);
+    }
+  }
+  const std::string frame = harness->globalFrame();
+  const auto replay_started = std::chrono::steady_clock::now();
+  for (int pass = 0; pass < repeat; ++pass) {
+    for (size_t i : replayed) {
+      const auto & r = records[i];
+      planner.createPlan(
+        toPose(r.start_x, r.start_y, r.start_qz, r.start_qw, frame),
+        toPose(r.goal_x, r.goal_y, r.goal_qz, r.goal_qw, frame));
+    }
+  }
+  const double replay_time =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - replay_started).count();
+
+  // Cleaning the planner up writes the rest of the replay log
+  harness->shutdown();
+
+  nav2_straightline_planner::PlanLog replay_log;
+  try {
+    replay_log = nav2_straightline_planner::readPlanLog(replay_filename);
+  } catch (std::exception & e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+
+  // Replay records are matched with their requests past the dropped ones
+  const size_t requests = replayed.size() * repeat;
+  std::vector<size_t> request_indices;
+  request_indices.reserve(replay_log.records.size());
+  size_t request = 0;
+  for (const auto & replay : replay_log.records) {
+    request += replay.dropped_before;
+    request_indices.push_back(request++);
+  }
+  const uint64_t trailing_drops =
+    replay_log.dropped - (request - request_indices.size());
+  if (request > requests || request + trailing_drops != requests) {
+    std::fprintf(
+      stderr, "Replay log holds %zu requests and %lu drops instead of %zu, is it truncated?\n",
+      replay_log.records.size(), static_cast<unsigned long>(replay_log.dropped), requests);
+    return 1;
+  }
+
+  std::vector<int64_t> recorded_ns, replayed_ns;
+  size_t path_mismatches = 0, costmap_mismatches = 0;
+  for (size_t i = 0; i < replay_log.records.size(); ++i) {
+    const size_t request_index = request_indices[i];
+    const auto & recorded = records[replayed[request_index % replayed.size()]];
+    const auto & replay = replay_log.records[i];
+    if (request_index < replayed.size()) {
+      recorded_ns.push_back(recorded.duration_ns);
+      path_mismatches += recorded.path_poses != replay.path_poses;
+      costmap_mismatches += recorded.costmap_checksum != replay.costmap_checksum;
+    }
+    replayed_ns.push_back(replay.duration_ns);
+  }
+
+  std::printf(
+    "Replayed %zu of %zu requests %d times in %.3f s (%zu with via points skipped)\n",
+    replayed.size(), records.size(), repeat, replay_time, records.size() - replayed.size());
+  if (plan_log.dropped > 0 || replay_log.dropped > 0) {
+    std::printf(
+      "Requests dropped by the recorder: %lu recorded, %lu replayed\n",
+      static_cast<unsigned long>(plan_log.dropped),
+      static_cast<unsigned long>(replay_log.dropped));
+  }
+  std::printf("%-10s%10s%10s%10s%10s\n", "time [ms]", "p50", "p90", "p99", "max");
+  for (const auto & row : {std::make_pair("recorded", &recorded_ns),
+      std::make_pair("replayed", &replayed_ns)})
+  {
+    std::printf(
+      "%-10s%10.3f%10.3f%10.3f%10.3f\n", row.first,
+      nav2_straightline_planner::percentileMs(*row.second, 50.0),
+      nav2_straightline_planner::percentileMs(*row.second, 90.0),
+      nav2_straightline_planner::percentileMs(*row.second, 99.0),
+      nav2_straightline_planner::percentileMs(*row.second, 100.0));
+  }
+  std::printf("Path size mismatches: %zu\n", path_mismatches);
+  std::printf("Costmap checksum mismatches: %zu\n", costmap_mismatches);
+
+  rclcpp::shutdown();
+  return path_mismatches > 0 ? 2 : 0;
+}
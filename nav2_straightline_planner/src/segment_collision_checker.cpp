@@ -0,0 +1,429 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_straightline_planner/segment_collision_checker.hpp"
+
+namespace nav2_straightline_planner
+{
+
+void SegmentCollisionChecker::setCostThreshold(unsigned char cost_threshold, bool allow_unknown)
+{
+  cost_threshold_ = cost_threshold;
+  allow_unknown_ = allow_unknown;
+  unknown_cost_ = allow_unknown ? 0 : nav2_costmap_2d::NO_INFORMATION;
+}
+
+void SegmentCollisionChecker::setGrid(
+  const unsigned char * costs, unsigned int size_x, unsigned int size_y,
+  double resolution, double origin_x, double origin_y)
+{
+  costs_ = costs;
+  size_x_ = size_x;
+  size_y_ = size_y;
+  resolution_ = resolution;
+  origin_x_ = origin_x;
+  origin_y_ = origin_y;
+}
+
+bool SegmentCollisionChecker::lineCollides(
+  double wx0, double wy0, double wx1, double wy1) const
+{
+  const Ray ray{
+    {(wx0 - origin_x_) / resolution_, (wy0 - origin_y_) / resolution_},
+    {(wx1 - wx0) / resolution_, (wy1 - wy0) / resolution_}};
+  return walkCollides(
+    ray, pyramid_ ? pyramid_->levels() : 0, 0.0, 1.0, INT_MIN, INT_MIN, INT_MAX, INT_MAX);
+}
+
+bool SegmentCollisionChecker::walkCollides(
+  const Ray & ray, unsigned int level, double t0, double t1,
+  int min_x, int min_y, int max_x, int max_y) const
+{
+  const double scale = level > 0 ? pyramid_->blockSize(level) : 1.0;
+  auto cell = [scale](double coordinate, int min, int max) {
+      return std::min(std::max(static_cast<int>(std::floor(coordinate / scale)), min), max);
+    };
+  int cx = cell(ray.origin.x + t0 * ray.direction.x, min_x, max_x);
+  int cy = cell(ray.origin.y + t0 * ray.direction.y, min_y, max_y);
+  const int end_x = cell(ray.origin.x + t1 * ray.direction.x, min_x, max_x);
+  const int end_y = cell(ray.origin.y + t1 * ray.direction.y, min_y, max_y);
+  const int step_x = ray.direction.x > 0.0 ? 1 : -1;
+  const int step_y = ray.direction.y > 0.0 ? 1 : -1;
+
+  // Ray parameter t of the next cell border crossings and between borders
+  const double inf = std::numeric_limits<double>::infinity();
+  double t_delta_x = inf, t_delta_y = inf, t_max_x = inf, t_max_y = inf;
+  if (ray.direction.x != 0.0) {
+    t_delta_x = scale / std::abs(ray.direction.x);
+    t_max_x = ((cx + (step_x > 0 ? 1 : 0)) * scale - ray.origin.x) / ray.direction.x;
+  }
+  if (ray.direction.y != 0.0) {
+    t_delta_y = scale / std::abs(ray.direction.y);
+    t_max_y = ((cy + (step_y > 0 ? 1 : 0)) * scale - ray.origin.y) / ray.direction.y;
+  }
+
+  double t_enter = t0;
+  for (int n = std::abs(end_x - cx) + std::abs(end_y - cy); ; --n) {
+    const double t_exit = std::min(std::min(t_max_x, t_max_y), t1);
+    if (cellCollides(level, cx, cy)) {
+      if (level == 0) {
+        return true;
+      }
+      const int block = CostPyramid::BLOCK_SIZE;
+      if (walkCollides(
+          ray, level - 1, t_enter, t_exit,
+          cx * block, cy * block, cx * block + block - 1, cy * block + block - 1))
+      {
+        return true;
+      }
+    }
+    if (n == 0) {
+      return false;
+    }
+    if (t_max_x < t_max_y) {
+      cx += step_x;
+      t_enter = t_max_x;
+      t_max_x += t_delta_x;
+    } else {
+      cy += step_y;
+      t_enter = t_max_y;
+      t_max_y += t_delta_y;
+    }
+  }
+}
+
+bool SegmentCollisionChecker::cellCollides(unsigned int level, int x, int y) const
+{
+  const int size_x = level > 0 ? pyramid_->sizeX(level) : size_x_;
+  const int size_y = level > 0 ? pyramid_->sizeY(level) : size_y_;
+  if (x < 0 || y < 0 || x >= size_x || y >= size_y) {
+    return !allow_unknown_;
+  }
+  if (level > 0) {
+    return pyramid_->blockMax(level, x, y) >= cost_threshold_;
+  }
+  unsigned char cost;
+  if (snapshot_) {
+    int min_x, max_x;
+    const unsigned char * cells = snapshot_->row(y, min_x, max_x);
+    if (!cells || x < min_x || x > max_x) {
+      return true;
+    }
+    cost = cells[x - min_x];
+  } else {
+    cost = costs_[static_cast<size_t>(y) * size_x_ + x];
+  }
+  if (cost == nav2_costmap_2d::NO_INFORMATION) {
+    cost = unknown_cost_;
+  }
+  return cost >= cost_threshold_;
+}
+
+bool SegmentCollisionChecker::footprintCollides(
+  double wx0, double wy0, double wx1, double wy1,
+  const std::vector<geometry_msgs::msg::Point> & footprint)
+{
+  if (footprint.empty()) {
+    return lineCollides(wx0, wy0, wx1, wy1);
+  }
+  sweepFootprint(wx0, wy0, wx1, wy1, footprint);
+  return spansCollide();
+}
+
+void SegmentCollisionChecker::sweepFootprint(
+  double wx0, double wy0, double wx1, double wy1,
+  const std::vector<geometry_msgs::msg::Point> & footprint)
+{
+  sweepFootprint(wx0, wy0, wx1, wy1, std::atan2(wy1 - wy0, wx1 - wx0), footprint);
+}
+
+void SegmentCollisionChecker::sweepFootprint(
+  double wx0, double wy0, double wx1, double wy1, double start_yaw,
+  const std::vector<geometry_msgs::msg::Point> & footprint)
+{
+  if (footprint.empty()) {
+    sweepLine(wx0, wy0, wx1, wy1);
+    return;
+  }
+
+  // Footprint facing the segment direction at both ends
+  const double yaw = wx0 == wx1 && wy0 == wy1 ? start_yaw : std::atan2(wy1 - wy0, wx1 - wx0);
+  points_.clear();
+  addFootprint(wx0, wy0, yaw, 1.0, footprint);
+  addFootprint(wx1, wy1, yaw, 1.0, footprint);
+  convexHull();
+  clearRows();
+  addHullRows();
+
+  // Turn in place, rasterized apart so that it does not widen the whole segment. The
+  // vertices move on arcs around the start; every arc step lies in the triangle of its
+  // chord and of the tangents at its ends, whose apex is the vertex at the mid angle
+  // pushed away by 1 / cos(step / 2)
+  const double turn = std::remainder(yaw - start_yaw, 2.0 * M_PI);
+  if (turn != 0.0) {
+    const int steps = static_cast<int>(std::ceil(std::abs(turn) / (M_PI / 8.0)));
+    const double step = turn / steps;
+    const double apex_scale = 1.0 / std::cos(step / 2.0);
+    points_.clear();
+    for (int i = 0; i <= steps; ++i) {
+      addFootprint(wx0, wy0, start_yaw + i * step, 1.0, footprint);
+      if (i < steps) {
+        addFootprint(wx0, wy0, start_yaw + (i + 0.5) * step, apex_scale, footprint);
+      }
+    }
+    convexHull();
+    addHullRows();
+  }
+  rowsToSpans();
+}
+
+void SegmentCollisionChecker::addFootprint(
+  double wx, double wy, double yaw, double scale,
+  const std::vector<geometry_msgs::msg::Point> & footprint)
+{
+  const double cos_yaw = scale * std::cos(yaw);
+  const double sin_yaw = scale * std::sin(yaw);
+  for (const auto & p : footprint) {
+    points_.push_back(
+      {(wx + p.x * cos_yaw - p.y * sin_yaw - origin_x_) / resolution_,
+        (wy + p.x * sin_yaw + p.y * cos_yaw - origin_y_) / resolution_});
+  }
+}
+
+void SegmentCollisionChecker::sweepLine(double wx0, double wy0, double wx1, double wy1)
+{
+  points_.clear();
+  points_.push_back({(wx0 - origin_x_) / resolution_, (wy0 - origin_y_) / resolution_});
+  points_.push_back({(wx1 - origin_x_) / resolution_, (wy1 - origin_y_) / resolution_});
+  convexHull();
+  rasterize();
+  // Cells on the other side of a border the DDA rounding may step to
+  for (auto & span : spans_) {
+    --span.min_x;
+    ++span.max_x;
+  }
+}
+
+void SegmentCollisionChecker::clipSpans(int min_x, int min_y, int max_x, int max_y)
+{
+  size_t kept = 0;
+  for (const auto & span : spans_) {
+    if (span.row < min_y || span.row >= max_y) {
+      continue;
+    }
+    const int span_min_x = std::max(span.min_x, min_x);
+    const int span_max_x = std::min(span.max_x, max_x - 1);
+    if (span_min_x <= span_max_x) {
+      spans_[kept++] = {span.row, span_min_x, span_max_x};
+    }
+  }
+  spans_.resize(kept);
+}
+
+bool SegmentCollisionChecker::spansCollide() const
+{
+  for (const auto & span : spans_) {
+    if (spanCollides(span)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SegmentCollisionChecker::convexHull()
+{
+  std::sort(
+    points_.begin(), points_.end(), [](const Vec2 & a, const Vec2 & b) {
+      return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+  auto cross = [](const Vec2 & o, const Vec2 & a, const Vec2 & b) {
+      return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    };
+
+  // Lower then upper hull, the last point of each being the first of the other
+  hull_.resize(2 * points_.size());
+  size_t k = 0;
+  for (size_t i = 0; i < points_.size(); ++i) {
+    while (k >= 2 && cross(hull_[k - 2], hull_[k - 1], points_[i]) <= 0.0) {
+      --k;
+    }
+    hull_[k++] = points_[i];
+  }
+  for (size_t i = points_.size() - 1, lower = k + 1; i > 0; --i) {
+    while (k >= lower && cross(hull_[k - 2], hull_[k - 1], points_[i - 1]) <= 0.0) {
+      --k;
+    }
+    hull_[k++] = points_[i - 1];
+  }
+  hull_.resize(std::max<size_t>(k - 1, 1));
+}
+
+void SegmentCollisionChecker::rasterize()
+{
+  clearRows();
+  addHullRows();
+  rowsToSpans();
+}
+
+void SegmentCollisionChecker::clearRows()
+{
+  first_row_ = 0;
+  row_min_.clear();
+  row_max_.clear();
+}
+
+void SegmentCollisionChecker::addHullRows()
+{
+  double min_y = hull_[0].y, max_y = hull_[0].y;
+  for (const auto & p : hull_) {
+    min_y = std::min(min_y, p.y);
+    max_y = std::max(max_y, p.y);
+  }
+  const int hull_first_row = static_cast<int>(std::floor(min_y));
+  const int hull_last_row = static_cast<int>(std::floor(max_y));
+  if (row_min_.empty()) {
+    first_row_ = hull_first_row;
+  }
+  if (hull_first_row < first_row_) {
+    row_min_.insert(row_min_.begin(), first_row_ - hull_first_row, INT_MAX);
+    row_max_.insert(row_max_.begin(), first_row_ - hull_first_row, INT_MIN);
+    first_row_ = hull_first_row;
+  }
+  const size_t rows = std::max<size_t>(row_min_.size(), hull_last_row - first_row_ + 1);
+  row_min_.resize(rows, INT_MAX);
+  row_max_.resize(rows, INT_MIN);
+
+  // The polygon is convex, so its extent in a row is set by the edges crossing the row
+  for (size_t i = 0; i < hull_.size(); ++i) {
+    Vec2 a = hull_[i];
+    Vec2 b = hull_[(i + 1) % hull_.size()];
+    if (a.y > b.y) {
+      std::swap(a, b);
+    }
+    const double dxdy = b.y > a.y ? (b.x - a.x) / (b.y - a.y) : 0.0;
+    const int last_row = static_cast<int>(std::floor(b.y));
+    for (int row = static_cast<int>(std::floor(a.y)); row <= last_row; ++row) {
+      // Part of the edge within the row, the whole edge if horizontal
+      double x_low = a.x, x_high = b.x;
+      if (b.y > a.y) {
+        x_low = a.x + (std::max(a.y, static_cast<double>(row)) - a.y) * dxdy;
+        x_high = a.x + (std::min(b.y, static_cast<double>(row + 1)) - a.y) * dxdy;
+      }
+      const int r = row - first_row_;
+      row_min_[r] = std::min(row_min_[r], static_cast<int>(std::floor(std::min(x_low, x_high))));
+      row_max_[r] = std::max(row_max_[r], static_cast<int>(std::floor(std::max(x_low, x_high))));
+    }
+  }
+}
+
+void SegmentCollisionChecker::rowsToSpans()
+{
+  spans_.clear();
+  for (size_t r = 0; r < row_min_.size(); ++r) {
+    if (row_min_[r] <= row_max_[r]) {
+      spans_.push_back({first_row_ + static_cast<int>(r), row_min_[r], row_max_[r]});
+    }
+  }
+}
+
+bool SegmentCollisionChecker::spanCollides(const CellSpan & span) const
+{
+  if (span.row < 0 || span.row >= static_cast<int>(size_y_)) {
+    return !allow_unknown_;
+  }
+  const int min_x = std::max(span.min_x, 0);
+  const int max_x = std::min(span.max_x, static_cast<int>(size_x_) - 1);
+  if ((min_x != span.min_x || max_x != span.max_x) && !allow_unknown_) {
+    return true;
+  }
+  if (min_x > max_x) {
+    return false;
+  }
+
+  // Row cells, from the one at row_min_x
+  const unsigned char * row;
+  int row_min_x = 0;
+  if (snapshot_) {
+    int row_max_x;
+    row = snapshot_->row(span.row, row_min_x, row_max_x);
+    if (!row || min_x < row_min_x || max_x > row_max_x) {
+      return true;
+    }
+  } else {
+    row = costs_ + static_cast<size_t>(span.row) * size_x_;
+  }
+  const unsigned int levels = pyramid_ ? pyramid_->levels() : 0;
+  const int block = CostPyramid::BLOCK_SIZE;
+  for (int x = min_x; x <= max_x; ) {
+    // Skips the coarsest free block holding x
+    int end_x = max_x;
+    if (levels > 0) {
+      bool free_block = false;
+      for (unsigned int level = levels; level > 0 && !free_block; --level) {
+        const int size = pyramid_->blockSize(level);
+        if (pyramid_->blockMax(level, x / size, span.row / size) < cost_threshold_) {
+          x = (x / size + 1) * size;
+          free_block = true;
+        }
+      }
+      if (free_block) {
+        continue;
+      }
+      end_x = std::min(max_x, (x / block + 1) * block - 1);
+    }
+
+    // Branchless max over the row, so the compiler can vectorize it
+    unsigned char max_cost = 0;
+    for (; x <= end_x; ++x) {
+      const unsigned char cell = row[x - row_min_x];
+      const unsigned char cost = cell == nav2_costmap_2d::NO_INFORMATION ? unknown_cost_ : cell;
+      max_cost = std::max(max_cost, cost);
+    }
+    if (max_cost >= cost_threshold_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace nav2_straightline_planner
@@ -38,9 +38,16 @@
  * https://navigation.ros.org/tutorials/docs/writing_new_nav2planner_plugin.html
  *********************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <functional>
+#include <limits>
 #include <string>
 #include <memory>
+#include <stdexcept>
+#include <vector>
+#include "nav2_costmap_2d/cost_values.hpp"
 #include "nav2_util/node_utils.hpp"
 
 #include "nav2_straightline_planner/straight_line_planner.hpp"
@@ -56,6 +63,7 @@ void StraightLine::configure(
   node_ = parent.lock();
   name_ = name;
   tf_ = tf;
+  costmap_ros_ = costmap_ros;
   costmap_ = costmap_ros->getCostmap();
   global_frame_ = costmap_ros->getGlobalFrameID();
 
@@ -64,6 +72,163 @@ void StraightLine::configure(
     node_, name_ + ".interpolation_resolution", rclcpp::ParameterValue(
       0.1));
   node_->get_parameter(name_ + ".interpolation_resolution", interpolation_resolution_);
+
+  // Collision checking parameters. The centre line is checked against inscribed (inflated)
+  // costs, while the swept footprint is only checked against lethal ones
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".collision_checking", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".collision_checking", collision_checking_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".use_footprint", rclcpp::ParameterValue(true));
+  node_->get_parameter(name_ + ".use_footprint", use_footprint_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".allow_unknown", rclcpp::ParameterValue(true));
+  node_->get_parameter(name_ + ".allow_unknown", allow_unknown_);
+  collision_cost_threshold_ = use_footprint_ ?
+    nav2_costmap_2d::LETHAL_OBSTACLE : nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE;
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".use_leg_headings", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".use_leg_headings", use_leg_headings_);
+
+  // Start and goal relocation parameters
+  double relocation_max_distance;
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".relocate_start", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".relocate_start", relocate_start_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".relocate_goal", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".relocate_goal", relocate_goal_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".relocation_max_distance", rclcpp::ParameterValue(1.0));
+  node_->get_parameter(name_ + ".relocation_max_distance", relocation_max_distance);
+  relocation_radius_ =
+    static_cast<int>(std::ceil(relocation_max_distance / costmap_->getResolution()));
+
+  // Cost pyramid parameters. The cells changed by every costmap update are reported by a
+  // layer appended to the costmap, the pyramid is updated over them before a check
+  int pyramid_levels;
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".use_cost_pyramid", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".use_cost_pyramid", use_cost_pyramid_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".cost_pyramid_levels", rclcpp::ParameterValue(3));
+  node_->get_parameter(name_ + ".cost_pyramid_levels", pyramid_levels);
+
+  // Previous plan reuse parameters. A reused plan is only checked against the costmap cells
+  // changed since, which are reported by the same layer as the cost pyramid ones
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".reuse_previous_plan", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".reuse_previous_plan", reuse_previous_plan_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".reuse_max_deviation", rclcpp::ParameterValue(0.25));
+  node_->get_parameter(name_ + ".reuse_max_deviation", reuse_max_deviation_);
+  {
+    std::lock_guard<std::mutex> lock(previous_plan_mutex_);
+    previous_path_.poses.clear();
+  }
+
+  if (collision_checking_ && use_cost_pyramid_) {
+    cost_pyramid_.configure(
+      std::max(pyramid_levels, 1),
+      allow_unknown_ ? nav2_costmap_2d::FREE_SPACE : nav2_costmap_2d::NO_INFORMATION);
+  }
+  if (collision_checking_ && (use_cost_pyramid_ || reuse_previous_plan_)) {
+    pyramid_dirty_.reset();
+    plan_dirty_.reset();
+    updated_cells_layer_ = UpdatedCellsLayer::attach(
+      costmap_ros_->getLayeredCostmap(),
+      [this](unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1) {
+        pyramid_dirty_.add(x0, y0, x1, y1);
+        plan_dirty_.add(x0, y0, x1, y1);
+      });
+  }
+
+  // Speed profile limits, shared by the speed mask ETA and the timed path poses
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".max_velocity", rclcpp::ParameterValue(0.5));
+  node_->get_parameter(name_ + ".max_velocity", max_velocity_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".max_acceleration", rclcpp::ParameterValue(1.0));
+  node_->get_parameter(name_ + ".max_acceleration", max_acceleration_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".timed_path", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".timed_path", timed_path_);
+  if (timed_path_ && max_velocity_ <= 0.0) {
+    RCLCPP_WARN(
+      node_->get_logger(), "max_velocity of %s must be positive for a timed path, disabling it",
+      name_.c_str());
+    timed_path_ = false;
+  }
+
+  // Speed filter mask parameters, defaults are matching the costmap filters demo
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".use_speed_mask", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".use_speed_mask", use_speed_mask_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".speed_mask_topic", rclcpp::ParameterValue("/speed_filter_mask"));
+  node_->get_parameter(name_ + ".speed_mask_topic", speed_mask_topic_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".speed_mask_base", rclcpp::ParameterValue(100.0));
+  node_->get_parameter(name_ + ".speed_mask_base", speed_mask_base_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".speed_mask_multiplier", rclcpp::ParameterValue(-1.0));
+  node_->get_parameter(name_ + ".speed_mask_multiplier", speed_mask_multiplier_);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".speed_limit_in_percent", rclcpp::ParameterValue(true));
+  node_->get_parameter(name_ + ".speed_limit_in_percent", speed_limit_in_percent_);
+
+  if (use_speed_mask_) {
+    // Filter masks are published once by a latched map server
+    speed_mask_sub_ = node_->create_subscription<nav_msgs::msg::OccupancyGrid>(
+      speed_mask_topic_, rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable(),
+      std::bind(&StraightLine::speedMaskCallback, this, std::placeholders::_1));
+    speed_limits_pub_ = node_->create_publisher<std_msgs::msg::Float32MultiArray>(
+      name_ + "/speed_limits", 1);
+    eta_pub_ = node_->create_publisher<std_msgs::msg::Float64>(name_ + "/eta", 1);
+  }
+
+  // Plan log recording parameters
+  std::string record_file;
+  int record_queue_size;
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".record_file", rclcpp::ParameterValue(""));
+  node_->get_parameter(name_ + ".record_file", record_file);
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".record_queue_size", rclcpp::ParameterValue(1024));
+  node_->get_parameter(name_ + ".record_queue_size", record_queue_size);
+  if (!record_file.empty()) {
+    try {
+      plan_recorder_ = std::make_unique<PlanRecorder>(
+        record_file, static_cast<size_t>(std::max(record_queue_size, 1)));
+      RCLCPP_INFO(node_->get_logger(), "Recording plan requests to %s", record_file.c_str());
+    } catch (const std::runtime_error & e) {
+      RCLCPP_ERROR(node_->get_logger(), "Plan requests are not recorded: %s", e.what());
+    }
+  }
+
+  // Compact path parameters
+  bool publish_compact_path;
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".publish_compact_path", rclcpp::ParameterValue(false));
+  node_->get_parameter(name_ + ".publish_compact_path", publish_compact_path);
+  if (publish_compact_path && timed_path_ && use_speed_mask_) {
+    // Stamps along the speed limited profile can't be expanded from the polyline
+    RCLCPP_WARN(
+      node_->get_logger(), "Compact path of %s is not supported with a speed mask timed path, "
+      "disabling it", name_.c_str());
+    publish_compact_path = false;
+  }
+  if (publish_compact_path) {
+    compact_path_pub_ = node_->create_publisher<msg::CompactPath>(name_ + "/compact_path", 1);
+  }
+
+  if (reuse_previous_plan_ && use_speed_mask_) {
+    // The speed limits and ETA are published for whole plans only
+    RCLCPP_WARN(
+      node_->get_logger(), "Previous plan reuse of %s is not supported with the speed mask, "
+      "disabling it", name_.c_str());
+    reuse_previous_plan_ = false;
+  }
 }
 
 void StraightLine::cleanup()
@@ -71,6 +236,23 @@ void StraightLine::cleanup()
   RCLCPP_INFO(
     node_->get_logger(), "CleaningUp plugin %s of type NavfnPlanner",
     name_.c_str());
+  if (updated_cells_layer_) {
+    updated_cells_layer_->detach(costmap_ros_->getLayeredCostmap());
+    updated_cells_layer_.reset();
+  }
+  speed_mask_sub_.reset();
+  speed_limits_pub_.reset();
+  eta_pub_.reset();
+  speed_mask_.reset();
+  compact_path_pub_.reset();
+  if (plan_recorder_) {
+    if (plan_recorder_->dropped() > 0) {
+      RCLCPP_WARN(
+        node_->get_logger(), "%lu plan requests were not recorded, the record queue was full",
+        static_cast<unsigned long>(plan_recorder_->dropped()));
+    }
+    plan_recorder_.reset();
+  }
 }
 
 void StraightLine::activate()
@@ -78,6 +260,13 @@ void StraightLine::activate()
   RCLCPP_INFO(
     node_->get_logger(), "Activating plugin %s of type NavfnPlanner",
     name_.c_str());
+  if (use_speed_mask_) {
+    speed_limits_pub_->on_activate();
+    eta_pub_->on_activate();
+  }
+  if (compact_path_pub_) {
+    compact_path_pub_->on_activate();
+  }
 }
 
 void StraightLine::deactivate()
@@ -85,13 +274,440 @@ void StraightLine::deactivate()
   RCLCPP_INFO(
     node_->get_logger(), "Deactivating plugin %s of type NavfnPlanner",
     name_.c_str());
+  if (use_speed_mask_) {
+    speed_limits_pub_->on_deactivate();
+    eta_pub_->on_deactivate();
+  }
+  if (compact_path_pub_) {
+    compact_path_pub_->on_deactivate();
+  }
+}
+
+void StraightLine::speedMaskCallback(const nav_msgs::msg::OccupancyGrid::SharedPtr msg)
+{
+  // Masks are sampled at path poses directly, so they have to share the global frame
+  if (msg->header.frame_id != global_frame_) {
+    RCLCPP_WARN(
+      node_->get_logger(), "Speed mask is in %s frame, but planner works in %s frame. Ignoring it",
+      msg->header.frame_id.c_str(), global_frame_.c_str());
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(speed_mask_mutex_);
+  speed_mask_ = msg;
+}
+
+StraightLine::PlanScratch & StraightLine::planScratch()
+{
+  static thread_local PlanScratch scratch;
+  return scratch;
+}
+
+bool StraightLine::polylineCollides(
+  const std::vector<geometry_msgs::msg::Point> & corners, double start_yaw,
+  uint64_t & plan_generation)
+{
+  std::vector<geometry_msgs::msg::Point> footprint;
+  if (use_footprint_) {
+    footprint = costmap_ros_->getRobotFootprint();
+  }
+  PlanScratch & scratch = planScratch();
+  auto & leg_checkers = scratch.leg_checkers;
+  auto & leg_snapshots = scratch.leg_snapshots;
+  const size_t legs = corners.size() - 1;
+  if (leg_checkers.size() < legs) {
+    leg_checkers.resize(legs);
+    leg_snapshots.resize(legs);
+  }
+
+  std::shared_lock<std::shared_timed_mutex> pyramid_lock;
+  {
+    // Only the cells under the legs are copied while the costmap is locked,
+    // the checks then run on the copies while the costmap keeps updating
+    std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
+    const CostPyramid * pyramid = nullptr;
+    if (use_cost_pyramid_) {
+      // The pyramid can't be updated while concurrent checks read it. It is then left to
+      // a later request, and this one checks every cell unless nothing changed since
+      if (pyramid_mutex_.try_lock()) {
+        updatePyramid();
+        pyramid_mutex_.unlock();
+      }
+      if (pyramid_dirty_.empty() && cost_pyramid_.levels() > 0 &&
+        costmap_->getOriginX() == pyramid_origin_x_ && costmap_->getOriginY() == pyramid_origin_y_)
+      {
+        // Never blocks, the pyramid is only locked exclusively with the costmap locked
+        pyramid_lock = std::shared_lock<std::shared_timed_mutex>(pyramid_mutex_);
+        pyramid = &cost_pyramid_;
+      }
+    }
+    // The snapshots are up to date with every change so far
+    plan_dirty_.reset();
+    plan_generation = ++plan_generation_;
+    plan_origin_x_ = costmap_->getOriginX();
+    plan_origin_y_ = costmap_->getOriginY();
+    double yaw = start_yaw;
+    for (size_t leg = 0; leg < legs; ++leg) {
+      SegmentCollisionChecker & checker = leg_checkers[leg];
+      checker.setCostThreshold(collision_cost_threshold_, allow_unknown_);
+      checker.setPyramid(pyramid);
+      checker.setSnapshot(&leg_snapshots[leg]);
+      checker.setGrid(
+        nullptr, costmap_->getSizeInCellsX(), costmap_->getSizeInCellsY(),
+        costmap_->getResolution(), costmap_->getOriginX(), costmap_->getOriginY());
+      yaw = sweepLeg(checker, corners, leg, yaw, footprint);
+      leg_snapshots[leg].capture(
+        costmap_->getCharMap(), costmap_->getSizeInCellsX(), costmap_->getSizeInCellsY(),
+        checker.spans());
+    }
+  }
+
+  // Legs are checked in the calling thread, concurrent requests being the parallelism
+  bool collides = false;
+  for (size_t leg = 0; leg < legs && !collides; ++leg) {
+    if (use_footprint_) {
+      collides = leg_checkers[leg].spansCollide();
+    } else {
+      const auto & from = corners[leg];
+      const auto & to = corners[leg + 1];
+      collides = leg_checkers[leg].lineCollides(from.x, from.y, to.x, to.y);
+    }
+  }
+
+  if (plan_recorder_) {
+    uint32_t checksum = 2166136261u;
+    for (size_t leg = 0; leg < legs; ++leg) {
+      checksum = (checksum ^ leg_snapshots[leg].checksum()) * 16777619u;
+    }
+    scratch.costmap_checksum = checksum;
+  }
+  return collides;
+}
+
+double StraightLine::sweepLeg(
+  SegmentCollisionChecker & checker, const std::vector<geometry_msgs::msg::Point> & corners,
+  size_t leg, double start_yaw, const std::vector<geometry_msgs::msg::Point> & footprint) const
+{
+  const auto & from = corners[leg];
+  const auto & to = corners[leg + 1];
+  if (!use_footprint_) {
+    checker.sweepLine(from.x, from.y, to.x, to.y);
+  } else {
+    checker.sweepFootprint(from.x, from.y, to.x, to.y, start_yaw, footprint);
+  }
+  return from.x == to.x && from.y == to.y ? start_yaw : std::atan2(to.y - from.y, to.x - from.x);
+}
+
+bool StraightLine::relocate(geometry_msgs::msg::PoseStamped & pose, const char * pose_name)
+{
+  PlanScratch & scratch = planScratch();
+  if (scratch.free_cell_search_radius != relocation_radius_) {
+    scratch.free_cell_search.configure(static_cast<unsigned int>(relocation_radius_));
+    scratch.free_cell_search_radius = relocation_radius_;
+  }
+
+  const double old_x = pose.pose.position.x;
+  const double old_y = pose.pose.position.y;
+  unsigned int x, y, free_x, free_y;
+  {
+    std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
+    if (!costmap_->worldToMap(old_x, old_y, x, y)) {
+      // Outside of the costmap, left to the collision checks
+      return true;
+    }
+    if (!scratch.free_cell_search.find(
+        costmap_->getCharMap(), costmap_->getSizeInCellsX(), costmap_->getSizeInCellsY(),
+        x, y, nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE, allow_unknown_, free_x, free_y))
+    {
+      return false;
+    }
+    if (free_x == x && free_y == y) {
+      return true;
+    }
+    costmap_->mapToWorld(free_x, free_y, pose.pose.position.x, pose.pose.position.y);
+  }
+
+  RCLCPP_INFO(
+    node_->get_logger(), "Relocated %s from (%.2f, %.2f) to the free cell at (%.2f, %.2f)",
+    pose_name, old_x, old_y, pose.pose.position.x, pose.pose.position.y);
+  return true;
+}
+
+void StraightLine::updatePyramid()
+{
+  // Rolling costmaps move the grid under the pyramid; a resized grid is rebuilt by update()
+  if (cost_pyramid_.levels() == 0 ||
+    costmap_->getOriginX() != pyramid_origin_x_ || costmap_->getOriginY() != pyramid_origin_y_)
+  {
+    cost_pyramid_.rebuild(
+      costmap_->getCharMap(), costmap_->getSizeInCellsX(), costmap_->getSizeInCellsY());
+    pyramid_origin_x_ = costmap_->getOriginX();
+    pyramid_origin_y_ = costmap_->getOriginY();
+  } else if (!pyramid_dirty_.empty()) {
+    cost_pyramid_.update(
+      costmap_->getCharMap(), costmap_->getSizeInCellsX(), costmap_->getSizeInCellsY(),
+      pyramid_dirty_.min_x, pyramid_dirty_.min_y, pyramid_dirty_.max_x, pyramid_dirty_.max_y);
+  }
+  pyramid_dirty_.reset();
+}
+
+bool StraightLine::changedCellsCollide(
+  const std::vector<geometry_msgs::msg::Point> & corners, double start_yaw)
+{
+  std::vector<geometry_msgs::msg::Point> footprint;
+  if (use_footprint_) {
+    footprint = costmap_ros_->getRobotFootprint();
+  }
+  PlanScratch & scratch = planScratch();
+  if (scratch.leg_checkers.empty()) {
+    scratch.leg_checkers.resize(1);
+  }
+  SegmentCollisionChecker & checker = scratch.leg_checkers[0];
+
+  std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(*(costmap_->getMutex()));
+  if (previous_generation_ != plan_generation_ ||
+    costmap_->getOriginX() != plan_origin_x_ || costmap_->getOriginY() != plan_origin_y_)
+  {
+    // Another plan was checked since, or the cells of the check moved with a rolling costmap
+    return true;
+  }
+  if (plan_dirty_.empty()) {
+    return false;
+  }
+  checker.setCostThreshold(collision_cost_threshold_, allow_unknown_);
+  checker.setPyramid(nullptr);
+  checker.setSnapshot(nullptr);
+  checker.setGrid(
+    costmap_->getCharMap(), costmap_->getSizeInCellsX(), costmap_->getSizeInCellsY(),
+    costmap_->getResolution(), costmap_->getOriginX(), costmap_->getOriginY());
+  double yaw = start_yaw;
+  for (size_t leg = 0; leg + 1 < corners.size(); ++leg) {
+    // The widened centre line spans hold every cell the exact line check reads
+    yaw = sweepLeg(checker, corners, leg, yaw, footprint);
+    checker.clipSpans(plan_dirty_.min_x, plan_dirty_.min_y, plan_dirty_.max_x, plan_dirty_.max_y);
+    if (checker.spansCollide()) {
+      return true;
+    }
+  }
+  plan_dirty_.reset();
+  return false;
+}
+
+bool StraightLine::reusePreviousPlan(
+  const geometry_msgs::msg::PoseStamped & start,
+  const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+  const geometry_msgs::msg::PoseStamped & goal,
+  nav_msgs::msg::Path & global_path)
+{
+  auto same_pose = [](const geometry_msgs::msg::Pose & a, const geometry_msgs::msg::Pose & b) {
+      return a.position.x == b.position.x && a.position.y == b.position.y &&
+             a.orientation.z == b.orientation.z && a.orientation.w == b.orientation.w;
+    };
+  std::lock_guard<std::mutex> lock(previous_plan_mutex_);
+  if (previous_path_.poses.empty() || !same_pose(goal.pose, previous_goal_.pose) ||
+    via_poses.size() != previous_via_poses_.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < via_poses.size(); ++i) {
+    if (!same_pose(via_poses[i].pose, previous_via_poses_[i].pose)) {
+      return false;
+    }
+  }
+
+  // The robot only moves forward along the path, so the closest pose is searched from the
+  // previous one on
+  const auto & poses = previous_path_.poses;
+  const double sx = start.pose.position.x;
+  const double sy = start.pose.position.y;
+  size_t closest = previous_index_;
+  double closest_dist_sq = std::numeric_limits<double>::max();
+  for (size_t i = previous_index_; i < poses.size(); ++i) {
+    const double dx = poses[i].pose.position.x - sx;
+    const double dy = poses[i].pose.position.y - sy;
+    const double dist_sq = dx * dx + dy * dy;
+    if (dist_sq < closest_dist_sq) {
+      closest_dist_sq = dist_sq;
+      closest = i;
+    }
+  }
+
+  // Projection of the start on the path segment after the closest pose
+  geometry_msgs::msg::Point projection = poses[closest].pose.position;
+  double fraction = 0.0;
+  if (closest + 1 < poses.size()) {
+    const auto & next = poses[closest + 1].pose.position;
+    const double dx = next.x - projection.x;
+    const double dy = next.y - projection.y;
+    const double length_sq = dx * dx + dy * dy;
+    if (length_sq > 0.0) {
+      fraction = std::min(
+        std::max(((sx - projection.x) * dx + (sy - projection.y) * dy) / length_sq, 0.0), 1.0);
+      projection.x += fraction * dx;
+      projection.y += fraction * dy;
+    }
+  }
+  // Changed cells behind the previous projection were never checked
+  if (std::hypot(sx - projection.x, sy - projection.y) > reuse_max_deviation_ ||
+    (closest == previous_index_ && fraction < previous_fraction_))
+  {
+    return false;
+  }
+
+  // Rest of the polyline, from the projection through the corners still ahead
+  const size_t leg = std::upper_bound(
+    previous_leg_starts_.begin(), previous_leg_starts_.end(), closest) -
+    previous_leg_starts_.begin() - 1;
+  std::vector<geometry_msgs::msg::Point> corners;
+  corners.reserve(previous_corners_.size() - leg);
+  corners.push_back(projection);
+  corners.insert(corners.end(), previous_corners_.begin() + leg + 1, previous_corners_.end());
+  // The robot following the previous path faces the leg it is on, so it only turns at the
+  // corners still ahead
+  const auto & leg_from = previous_corners_[leg];
+  const auto & leg_to = previous_corners_[leg + 1];
+  const double leg_yaw = std::atan2(leg_to.y - leg_from.y, leg_to.x - leg_from.x);
+  if (collision_checking_ && changedCellsCollide(corners, leg_yaw)) {
+    return false;
+  }
+  previous_index_ = closest;
+  previous_fraction_ = fraction;
+
+  // Stamps are shifted so that the projection is reached now
+  const rclcpp::Time plan_time = node_->now();
+  const rclcpp::Duration shift = plan_time - rclcpp::Time(poses[closest].header.stamp);
+  global_path.header.stamp = plan_time;
+  global_path.header.frame_id = global_frame_;
+  global_path.poses.reserve(poses.size() - closest);
+  global_path.poses.push_back(poses[closest]);
+  global_path.poses.back().pose.position = projection;
+  global_path.poses.back().header.stamp = plan_time;
+  for (size_t i = closest + 1; i < poses.size(); ++i) {
+    global_path.poses.push_back(poses[i]);
+    global_path.poses.back().header.stamp = rclcpp::Time(poses[i].header.stamp) + shift;
+  }
+  if (compact_path_pub_) {
+    publishCompactPath(
+      previous_corners_, poses.back().pose.orientation, closest, projection, plan_time);
+  }
+  return true;
+}
+
+void StraightLine::publishCompactPath(
+  const std::vector<geometry_msgs::msg::Point> & corners,
+  const geometry_msgs::msg::Quaternion & goal_orientation,
+  size_t skipped_poses, const geometry_msgs::msg::Point & start,
+  const rclcpp::Time & plan_time)
+{
+  msg::CompactPath compact_path;
+  compact_path.header.stamp = plan_time;
+  compact_path.header.frame_id = global_frame_;
+  compact_path.corners = corners;
+  compact_path.resolution = interpolation_resolution_;
+  compact_path.goal_orientation = goal_orientation;
+  compact_path.leg_headings = use_leg_headings_;
+  compact_path.skipped_poses = static_cast<uint32_t>(skipped_poses);
+  compact_path.start = start;
+  // Speed mask timed paths are never published
+  compact_path.max_velocity = timed_path_ ? max_velocity_ : 0.0;
+  compact_path.max_acceleration = max_acceleration_;
+  compact_path_pub_->publish(compact_path);
+}
+
+void StraightLine::storePreviousPlan(
+  const nav_msgs::msg::Path & global_path,
+  const std::vector<size_t> & leg_starts,
+  const std::vector<geometry_msgs::msg::Point> & corners,
+  const geometry_msgs::msg::PoseStamped & goal,
+  const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+  uint64_t plan_generation)
+{
+  std::lock_guard<std::mutex> lock(previous_plan_mutex_);
+  if (collision_checking_) {
+    // The changed cells of an older plan were reset by the newer check
+    std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> costmap_lock(
+      *(costmap_->getMutex()));
+    if (plan_generation != plan_generation_) {
+      return;
+    }
+  }
+  previous_path_ = global_path;
+  previous_leg_starts_ = leg_starts;
+  previous_corners_ = corners;
+  previous_goal_ = goal;
+  previous_via_poses_ = via_poses;
+  previous_generation_ = plan_generation;
+  previous_index_ = 0;
+  previous_fraction_ = 0.0;
+}
+
+double StraightLine::getSpeedLimit(
+  const nav_msgs::msg::OccupancyGrid & mask, double wx, double wy) const
+{
+  const double mx = std::floor((wx - mask.info.origin.position.x) / mask.info.resolution);
+  const double my = std::floor((wy - mask.info.origin.position.y) / mask.info.resolution);
+  if (mx < 0.0 || my < 0.0 || mx >= mask.info.width || my >= mask.info.height) {
+    // Outside of the mask there are no speed restrictions
+    return max_velocity_;
+  }
+
+  const signed char value =
+    mask.data[static_cast<size_t>(my) * mask.info.width + static_cast<size_t>(mx)];
+  return speedLimitFromMask(
+    value, speed_mask_base_, speed_mask_multiplier_, speed_limit_in_percent_, max_velocity_);
 }
 
 nav_msgs::msg::Path StraightLine::createPlan(
   const geometry_msgs::msg::PoseStamped & start,
   const geometry_msgs::msg::PoseStamped & goal)
+{
+  return createPlanThroughPoses(start, {}, goal);
+}
+
+nav_msgs::msg::Path StraightLine::createPlanThroughPoses(
+  const geometry_msgs::msg::PoseStamped & start,
+  const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+  const geometry_msgs::msg::PoseStamped & goal)
+{
+  if (!plan_recorder_) {
+    return planThroughPoses(start, via_poses, goal);
+  }
+
+  PlanScratch & scratch = planScratch();
+  scratch.costmap_checksum = 0;
+  const auto stamp = std::chrono::system_clock::now();
+  const auto started = std::chrono::steady_clock::now();
+  nav_msgs::msg::Path global_path = planThroughPoses(start, via_poses, goal);
+  const auto duration = std::chrono::steady_clock::now() - started;
+
+  PlanRecord plan_record;
+  plan_record.stamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    stamp.time_since_epoch()).count();
+  plan_record.start_x = start.pose.position.x;
+  plan_record.start_y = start.pose.position.y;
+  plan_record.start_qz = start.pose.orientation.z;
+  plan_record.start_qw = start.pose.orientation.w;
+  plan_record.goal_x = goal.pose.position.x;
+  plan_record.goal_y = goal.pose.position.y;
+  plan_record.goal_qz = goal.pose.orientation.z;
+  plan_record.goal_qw = goal.pose.orientation.w;
+  plan_record.via_points = static_cast<uint32_t>(via_poses.size());
+  plan_record.costmap_checksum = scratch.costmap_checksum;
+  plan_record.path_poses = static_cast<uint32_t>(global_path.poses.size());
+  plan_record.duration_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+  plan_recorder_->record(plan_record);
+  return global_path;
+}
+
+nav_msgs::msg::Path StraightLine::planThroughPoses(
+  const geometry_msgs::msg::PoseStamped & requested_start,
+  const std::vector<geometry_msgs::msg::PoseStamped> & via_poses,
+  const geometry_msgs::msg::PoseStamped & requested_goal)
 {
   nav_msgs::msg::Path global_path;
+  geometry_msgs::msg::PoseStamped start = requested_start;
+  geometry_msgs::msg::PoseStamped goal = requested_goal;
 
   // Checking if the goal and start state is in the global frame
   if (start.header.frame_id != global_frame_) {
@@ -108,36 +724,185 @@ nav_msgs::msg::Path StraightLine::createPlan(
     return global_path;
   }
 
+  for (const auto & via_pose : via_poses) {
+    if (via_pose.header.frame_id != global_frame_) {
+      RCLCPP_ERROR(
+        node_->get_logger(), "Planner will only except via points from %s frame",
+        global_frame_.c_str());
+      return global_path;
+    }
+  }
+
+  if (reuse_previous_plan_ && reusePreviousPlan(start, via_poses, goal, global_path)) {
+    return global_path;
+  }
+
+  if ((relocate_start_ && !relocate(start, "start")) ||
+    (relocate_goal_ && !relocate(goal, "goal")))
+  {
+    RCLCPP_WARN(
+      node_->get_logger(), "No free cell within relocation_max_distance of the start or goal");
+    return global_path;
+  }
+
+  // Corners of the polyline, the end of every leg starting the next one
+  std::vector<geometry_msgs::msg::Point> corners;
+  corners.reserve(via_poses.size() + 2);
+  corners.push_back(start.pose.position);
+  for (const auto & via_pose : via_poses) {
+    corners.push_back(via_pose.pose.position);
+  }
+  corners.push_back(goal.pose.position);
+
+  uint64_t plan_generation = 0;
+  const double start_yaw =
+    2.0 * std::atan2(start.pose.orientation.z, start.pose.orientation.w);
+  if (collision_checking_ && polylineCollides(corners, start_yaw, plan_generation)) {
+    RCLCPP_WARN(
+      node_->get_logger(), "Straight line from (%.2f, %.2f) to (%.2f, %.2f)%s is in collision",
+      start.pose.position.x, start.pose.position.y, goal.pose.position.x, goal.pose.position.y,
+      via_poses.empty() ? "" : " through the via points");
+    return global_path;
+  }
+
   global_path.poses.clear();
-  global_path.header.stamp = node_->now();
+  const rclcpp::Time plan_time = node_->now();
+  global_path.header.stamp = plan_time;
   global_path.header.frame_id = global_frame_;
-  // calculating the number of loops for current value of interpolation_resolution_
-  int total_number_of_loop = std::hypot(
-    goal.pose.position.x - start.pose.position.x,
-    goal.pose.position.y - start.pose.position.y) /
-    interpolation_resolution_;
-  double x_increment = (goal.pose.position.x - start.pose.position.x) / total_number_of_loop;
-  double y_increment = (goal.pose.position.y - start.pose.position.y) / total_number_of_loop;
-
-  for (int i = 0; i < total_number_of_loop; ++i) {
-    geometry_msgs::msg::PoseStamped pose;
-    pose.pose.position.x = start.pose.position.x + x_increment * i;
-    pose.pose.position.y = start.pose.position.y + y_increment * i;
-    pose.pose.position.z = 0.0;
-    pose.pose.orientation.x = 0.0;
-    pose.pose.orientation.y = 0.0;
-    pose.pose.orientation.z = 0.0;
-    pose.pose.orientation.w = 1.0;
-    pose.header.stamp = node_->now();
-    pose.header.frame_id = global_frame_;
-    global_path.poses.push_back(pose);
+  // calculating the number of loops of every leg for current value of interpolation_resolution_
+  auto leg_loops = [&](size_t leg) {
+      return static_cast<int>(std::hypot(
+               corners[leg + 1].x - corners[leg].x,
+               corners[leg + 1].y - corners[leg].y) / interpolation_resolution_);
+    };
+  size_t total_poses = 1;
+  for (size_t leg = 0; leg + 1 < corners.size(); ++leg) {
+    total_poses += leg_loops(leg);
+  }
+  global_path.poses.reserve(total_poses);
+  PlanScratch & scratch = planScratch();
+  scratch.leg_starts.clear();
+
+  // The speed mask is sampled in the same walk that generates the poses,
+  // feeding the forward pass of the time-optimal speed profile.
+  nav_msgs::msg::OccupancyGrid::SharedPtr speed_mask;
+  if (use_speed_mask_) {
+    std::lock_guard<std::mutex> lock(speed_mask_mutex_);
+    speed_mask = speed_mask_;
+    if (!speed_mask) {
+      RCLCPP_WARN(
+        node_->get_logger(), "No speed mask received on %s yet, assuming no speed limits",
+        speed_mask_topic_.c_str());
+    }
+    scratch.speed_limits.clear();
+    scratch.speed_limits.reserve(total_poses);
+    scratch.velocity_profile.reset(max_acceleration_);
+  }
+  auto annotate = [&](double x, double y) {
+      double ds = 0.0;
+      if (global_path.poses.size() > 1) {
+        const auto & last = global_path.poses[global_path.poses.size() - 2].pose.position;
+        ds = std::hypot(x - last.x, y - last.y);
+      }
+      const double limit = speed_mask ? getSpeedLimit(*speed_mask, x, y) : max_velocity_;
+      scratch.speed_limits.push_back(static_cast<float>(limit));
+      scratch.velocity_profile.addSample(ds, limit);
+    };
+
+  TrapezoidProfile leg_profile;
+  double leg_start = 0.0;
+  for (size_t leg = 0; leg + 1 < corners.size(); ++leg) {
+    const auto & from = corners[leg];
+    const auto & to = corners[leg + 1];
+    int total_number_of_loop = leg_loops(leg);
+    double x_increment = (to.x - from.x) / total_number_of_loop;
+    double y_increment = (to.y - from.y) / total_number_of_loop;
+
+    // Every leg is driven from rest to rest, its poses stamped along a trapezoidal profile.
+    // With the speed mask, the stamps come from the speed limited profile once it is done
+    const bool leg_timed = timed_path_ && !use_speed_mask_;
+    double leg_step = 0.0;
+    if (leg_timed) {
+      const double leg_length = std::hypot(to.x - from.x, to.y - from.y);
+      leg_step = leg_length / total_number_of_loop;
+      leg_profile.configure(leg_length, max_velocity_, max_acceleration_);
+    }
+
+    // Poses face their leg direction, so consecutive legs join with a heading change
+    geometry_msgs::msg::Quaternion orientation;
+    orientation.w = 1.0;
+    if (use_leg_headings_) {
+      const double yaw = std::atan2(to.y - from.y, to.x - from.x);
+      orientation.z = std::sin(yaw / 2.0);
+      orientation.w = std::cos(yaw / 2.0);
+    }
+
+    scratch.leg_starts.push_back(global_path.poses.size());
+    for (int i = 0; i < total_number_of_loop; ++i) {
+      geometry_msgs::msg::PoseStamped pose;
+      pose.pose.position.x = from.x + x_increment * i;
+      pose.pose.position.y = from.y + y_increment * i;
+      pose.pose.position.z = 0.0;
+      pose.pose.orientation = orientation;
+      pose.header.stamp = leg_timed ?
+        plan_time + rclcpp::Duration::from_seconds(leg_start + leg_profile.timeAt(leg_step * i)) :
+        plan_time;
+      pose.header.frame_id = global_frame_;
+      global_path.poses.push_back(pose);
+      if (use_speed_mask_) {
+        annotate(pose.pose.position.x, pose.pose.position.y);
+      }
+    }
+    if (leg_timed) {
+      leg_start += leg_profile.duration();
+    }
   }
 
   geometry_msgs::msg::PoseStamped goal_pose = goal;
-  goal_pose.header.stamp = node_->now();
+  goal_pose.header.stamp = plan_time + rclcpp::Duration::from_seconds(leg_start);
   goal_pose.header.frame_id = global_frame_;
   global_path.poses.push_back(goal_pose);
 
+  if (use_speed_mask_) {
+    annotate(goal.pose.position.x, goal.pose.position.y);
+    const double eta = scratch.velocity_profile.finalize();
+
+    if (timed_path_) {
+      if (std::isfinite(eta)) {
+        const auto & times = scratch.velocity_profile.times();
+        for (size_t i = 0; i < global_path.poses.size(); ++i) {
+          global_path.poses[i].header.stamp = plan_time + rclcpp::Duration::from_seconds(times[i]);
+        }
+      } else {
+        RCLCPP_WARN(
+          node_->get_logger(), "Speed mask stops the robot along the path, poses are not timed");
+      }
+    }
+
+    std_msgs::msg::Float32MultiArray speed_limits_msg;
+    speed_limits_msg.layout.dim.resize(1);
+    speed_limits_msg.layout.dim[0].label = "poses";
+    speed_limits_msg.layout.dim[0].size = scratch.speed_limits.size();
+    speed_limits_msg.layout.dim[0].stride = scratch.speed_limits.size();
+    speed_limits_msg.data = scratch.speed_limits;
+    speed_limits_pub_->publish(speed_limits_msg);
+
+    std_msgs::msg::Float64 eta_msg;
+    eta_msg.data = eta;
+    eta_pub_->publish(eta_msg);
+    RCLCPP_DEBUG(node_->get_logger(), "Straight line plan ETA: %.2f s", eta);
+  }
+
+  if (reuse_previous_plan_) {
+    storePreviousPlan(
+      global_path, scratch.leg_starts, corners, requested_goal, via_poses, plan_generation);
+  }
+  if (compact_path_pub_) {
+    // Not the start when the first leg is shorter than the interpolation resolution
+    publishCompactPath(
+      corners, goal.pose.orientation, 0, global_path.poses.front().pose.position, plan_time);
+  }
+
   return global_path;
 }
 
@@ -0,0 +1,175 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "nav2_util/node_utils.hpp"
+
+#include "nav2_straightline_planner/straight_line_via_points.hpp"
+
+namespace nav2_straightline_planner
+{
+
+namespace
+{
+
+// Distance from p to the segment [a, b]
+double segmentDistance(
+  const geometry_msgs::msg::Point & p, const geometry_msgs::msg::Point & a,
+  const geometry_msgs::msg::Point & b)
+{
+  const double dx = b.x - a.x;
+  const double dy = b.y - a.y;
+  const double length_sq = dx * dx + dy * dy;
+  double t = 0.0;
+  if (length_sq > 0.0) {
+    t = std::min(std::max(((p.x - a.x) * dx + (p.y - a.y) * dy) / length_sq, 0.0), 1.0);
+  }
+  return std::hypot(p.x - a.x - t * dx, p.y - a.y - t * dy);
+}
+
+bool samePose(const geometry_msgs::msg::Pose & a, const geometry_msgs::msg::Pose & b)
+{
+  return a.position.x == b.position.x && a.position.y == b.position.y &&
+         a.orientation.z == b.orientation.z && a.orientation.w == b.orientation.w;
+}
+
+}  // namespace
+
+void StraightLineViaPoints::configure(
+  const rclcpp_lifecycle::LifecycleNode::WeakPtr & parent,
+  std::string name, std::shared_ptr<tf2_ros::Buffer> tf,
+  std::shared_ptr<nav2_costmap_2d::Costmap2DROS> costmap_ros)
+{
+  // Legs are joined by heading changes, so poses face their leg by default
+  nav2_util::declare_parameter_if_not_declared(
+    parent.lock(), name + ".use_leg_headings", rclcpp::ParameterValue(true));
+  StraightLine::configure(parent, name, tf, costmap_ros);
+
+  nav2_util::declare_parameter_if_not_declared(
+    node_, name_ + ".via_point_tolerance", rclcpp::ParameterValue(0.25));
+  node_->get_parameter(name_ + ".via_point_tolerance", via_point_tolerance_);
+
+  via_points_sub_ = node_->create_subscription<nav_msgs::msg::Path>(
+    name_ + "/via_points", rclcpp::QoS(rclcpp::KeepLast(1)).transient_local().reliable(),
+    std::bind(&StraightLineViaPoints::viaPointsCallback, this, std::placeholders::_1));
+}
+
+void StraightLineViaPoints::cleanup()
+{
+  via_points_sub_.reset();
+  std::lock_guard<std::mutex> lock(via_poses_mutex_);
+  via_poses_.clear();
+  via_goal_set_ = false;
+  StraightLine::cleanup();
+}
+
+void StraightLineViaPoints::viaPointsCallback(const nav_msgs::msg::Path::SharedPtr msg)
+{
+  std::lock_guard<std::mutex> lock(via_poses_mutex_);
+  via_poses_ = msg->poses;
+  via_goal_set_ = false;
+  // Poses of the path may leave their own frame empty
+  for (auto & via_pose : via_poses_) {
+    if (via_pose.header.frame_id.empty()) {
+      via_pose.header.frame_id = msg->header.frame_id;
+    }
+  }
+  RCLCPP_INFO(
+    node_->get_logger(), "Planning through %zu via points", via_poses_.size());
+}
+
+nav_msgs::msg::Path StraightLineViaPoints::createPlan(
+  const geometry_msgs::msg::PoseStamped & start,
+  const geometry_msgs::msg::PoseStamped & goal)
+{
+  std::vector<geometry_msgs::msg::PoseStamped> via_poses;
+  {
+    std::lock_guard<std::mutex> lock(via_poses_mutex_);
+    consumeViaPoints(start, goal);
+    via_poses = via_poses_;
+  }
+  return createPlanThroughPoses(start, via_poses, goal);
+}
+
+void StraightLineViaPoints::consumeViaPoints(
+  const geometry_msgs::msg::PoseStamped & start,
+  const geometry_msgs::msg::PoseStamped & goal)
+{
+  if (via_poses_.empty()) {
+    return;
+  }
+  if (!via_goal_set_) {
+    via_goal_ = goal;
+    via_goal_set_ = true;
+    leg_from_ = start.pose.position;
+  } else if (!samePose(goal.pose, via_goal_.pose)) {
+    RCLCPP_INFO(
+      node_->get_logger(), "Goal changed, dropping the %zu via points left", via_poses_.size());
+    via_poses_.clear();
+    return;
+  }
+
+  // Via points are consumed in order, so that a polyline crossing itself can't skip any.
+  // One not reached within tolerance is still passed once the start is closer to its
+  // outgoing leg than to its incoming one
+  const auto & position = start.pose.position;
+  size_t reached = 0;
+  for (; reached < via_poses_.size(); ++reached) {
+    const auto & via = via_poses_[reached].pose.position;
+    const auto & next = reached + 1 < via_poses_.size() ?
+      via_poses_[reached + 1].pose.position : goal.pose.position;
+    if (std::hypot(position.x - via.x, position.y - via.y) > via_point_tolerance_ &&
+      segmentDistance(position, via, next) >= segmentDistance(position, leg_from_, via))
+    {
+      break;
+    }
+    leg_from_ = via;
+  }
+  if (reached > 0) {
+    via_poses_.erase(via_poses_.begin(), via_poses_.begin() + reached);
+    RCLCPP_INFO(
+      node_->get_logger(), "Reached %zu via points, %zu left", reached, via_poses_.size());
+  }
+}
+
+}  // namespace nav2_straightline_planner
+
+#include "pluginlib/class_list_macros.hpp"
+PLUGINLIB_EXPORT_CLASS(nav2_straightline_planner::StraightLineViaPoints, nav2_core::GlobalPlanner)
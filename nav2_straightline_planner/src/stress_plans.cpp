@@ -0,0 +1,232 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+// Hammers a planner plugin with createPlan calls from concurrent threads, to stress its
+// reentrancy and measure its throughput under contention:
+//   stress_plans [threads] [requests] [passes] --ros-args --params-file <params.yaml>
+// The global_costmap and the "stress" planner plugin are configured from the parameters,
+// as for replay_plans. Random requests over the costmap are first planned one at a time,
+// then every thread plans all of them passes times, from its own offset. On the paused
+// costmap, every concurrent path has to match its sequential one.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "geometry_msgs/msg/pose_stamped.hpp"
+#include "nav_msgs/msg/path.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+#include "nav2_straightline_planner/plan_harness.hpp"
+
+namespace
+{
+
+// Same poses, stamps aside
+bool samePath(const nav_msgs::msg::Path & a, const nav_msgs::msg::Path & b)
+{
+  if (a.poses.size() != b.poses.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.poses.size(); ++i) {
+    const auto & pa = a.poses[i].pose;
+    const auto & pb = b.poses[i].pose;
+    if (pa.position.x != pb.position.x || pa.position.y != pb.position.y ||
+      pa.orientation.z != pb.orientation.z || pa.orientation.w != pb.orientation.w)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Request
+{
+  geometry_msgs::msg::PoseStamped start, goal;
+};
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  rclcpp::init(argc, argv);
+  const auto args = rclcpp::remove_ros_arguments(argc, argv);
+  if (args.size() > 4) {
+    std::fprintf(
+      stderr,
+      "Usage: %s [threads] [requests] [passes] --ros-args --params-file <params.yaml>\n",
+      args[0].c_str());
+    return 1;
+  }
+  auto arg = [&args](size_t i, int default_value) {
+      return args.size() > i ? std::max(std::atoi(args[i].c_str()), 1) : default_value;
+    };
+  const int threads = arg(1, static_cast<int>(std::max(std::thread::hardware_concurrency(), 2u)));
+  const int request_count = arg(2, 1000);
+  const int passes = arg(3, 10);
+
+  // Reused plans and the plan log depend on the order of the requests
+  std::unique_ptr<nav2_straightline_planner::PlanHarness> harness;
+  try {
+    harness = std::make_unique<nav2_straightline_planner::PlanHarness>(
+      "plan_stress", "stress",
+      rclcpp::NodeOptions()
+      .append_parameter_override("stress.reuse_previous_plan", false)
+      .append_parameter_override("stress.record_file", ""));
+  } catch (std::exception & e) {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  nav2_core::GlobalPlanner & planner = harness->planner();
+
+  // Random planar poses over the costmap, a fixed seed keeps runs comparable
+  const nav2_costmap_2d::Costmap2D & costmap = harness->costmap();
+  const std::string frame = harness->globalFrame();
+  std::mt19937 random(42);
+  std::uniform_real_distribution<double> random_x(
+    costmap.getOriginX(), costmap.getOriginX() + costmap.getSizeInMetersX());
+  std::uniform_real_distribution<double> random_y(
+    costmap.getOriginY(), costmap.getOriginY() + costmap.getSizeInMetersY());
+  std::uniform_real_distribution<double> random_yaw(-M_PI, M_PI);
+  auto random_pose = [&]() {
+      geometry_msgs::msg::PoseStamped pose;
+      pose.header.frame_id = frame;
+      pose.pose.position.x = random_x(random);
+      pose.pose.position.y = random_y(random);
+      const double yaw = random_yaw(random);
+      pose.pose.orientation.z = std::sin(yaw / 2.0);
+      pose.pose.orientation.w = std::cos(yaw / 2.0);
+      return pose;
+    };
+  std::vector<Request> requests(request_count);
+  for (auto & request : requests) {
+    request.start = random_pose();
+    request.goal = random_pose();
+  }
+
+  std::vector<nav_msgs::msg::Path> expected(requests.size());
+  std::vector<int64_t> sequential_ns;
+  sequential_ns.reserve(requests.size());
+  size_t planned = 0;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const auto started = std::chrono::steady_clock::now();
+    expected[i] = planner.createPlan(requests[i].start, requests[i].goal);
+    sequential_ns.push_back(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started).count());
+    planned += !expected[i].poses.empty();
+  }
+
+  // Every thread starts at its own offset, so that different requests run concurrently
+  std::vector<std::vector<int64_t>> thread_ns(threads);
+  std::atomic<size_t> mismatches{0};
+  std::atomic<bool> go{false};
+  std::vector<std::thread> callers;
+  for (int t = 0; t < threads; ++t) {
+    callers.emplace_back(
+      [&, t]() {
+        auto & durations_ns = thread_ns[t];
+        durations_ns.reserve(requests.size() * passes);
+        const size_t offset = requests.size() * t / threads;
+        while (!go.load()) {
+          std::this_thread::yield();
+        }
+        for (int pass = 0; pass < passes; ++pass) {
+          for (size_t n = 0; n < requests.size(); ++n) {
+            const size_t i = (offset + n) % requests.size();
+            const auto started = std::chrono::steady_clock::now();
+            const auto path = planner.createPlan(requests[i].start, requests[i].goal);
+            durations_ns.push_back(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - started).count());
+            if (!samePath(path, expected[i])) {
+              mismatches.fetch_add(1);
+            }
+          }
+        }
+      });
+  }
+  const auto stress_started = std::chrono::steady_clock::now();
+  go = true;
+  for (auto & caller : callers) {
+    caller.join();
+  }
+  const double stress_time =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - stress_started).count();
+
+  harness->shutdown();
+
+  std::vector<int64_t> concurrent_ns;
+  for (const auto & durations_ns : thread_ns) {
+    concurrent_ns.insert(concurrent_ns.end(), durations_ns.begin(), durations_ns.end());
+  }
+  const size_t calls = concurrent_ns.size();
+  double sequential_time = 0.0;
+  for (int64_t duration_ns : sequential_ns) {
+    sequential_time += duration_ns * 1e-9;
+  }
+
+  std::printf(
+    "%zu requests (%zu with a path), %d threads x %d passes: %zu calls in %.3f s\n",
+    requests.size(), planned, threads, passes, calls, stress_time);
+  std::printf(
+    "Throughput [plans/s]: %.1f sequential, %.1f concurrent\n",
+    sequential_time > 0.0 ? requests.size() / sequential_time : 0.0,
+    stress_time > 0.0 ? calls / stress_time : 0.0);
+  std::printf("%-12s%10s%10s%10s%10s\n", "time [ms]", "p50", "p90", "p99", "max");
+  for (const auto & row : {std::make_pair("sequential", &sequential_ns),
+      std::make_pair("concurrent", &concurrent_ns)})
+  {
+    std::printf(
+      "%-12s%10.3f%10.3f%10.3f%10.3f\n", row.first,
+      nav2_straightline_planner::percentileMs(*row.second, 50.0),
+      nav2_straightline_planner::percentileMs(*row.second, 90.0),
+      nav2_straightline_planner::percentileMs(*row.second, 99.0),
+      nav2_straightline_planner::percentileMs(*row.second, 100.0));
+  }
+  std::printf("Paths differing from the sequential ones: %zu\n", mismatches.load());
+
+  rclcpp::shutdown();
+  return mismatches > 0 ? 2 : 0;
+}
@@ -0,0 +1,108 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "nav2_straightline_planner/updated_cells_layer.hpp"
+
+namespace nav2_straightline_planner
+{
+
+UpdatedCellsLayer::UpdatedCellsLayer(
+  nav2_costmap_2d::LayeredCostmap * layered_costmap, Callback callback)
+: callback_(std::move(callback))
+{
+  // Never initialized as a plugin, and never holding the costmap back
+  layered_costmap_ = layered_costmap;
+  name_ = "straightline_updated_cells";
+  current_ = true;
+  enabled_ = true;
+}
+
+std::shared_ptr<UpdatedCellsLayer> UpdatedCellsLayer::attach(
+  nav2_costmap_2d::LayeredCostmap * layered_costmap, Callback callback)
+{
+  std::shared_ptr<UpdatedCellsLayer> layer(
+    new UpdatedCellsLayer(layered_costmap, std::move(callback)));
+  // Layers are iterated by updateMap() with the costmap locked
+  std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(
+    *(layered_costmap->getCostmap()->getMutex()));
+  layered_costmap->addPlugin(layer);
+  return layer;
+}
+
+void UpdatedCellsLayer::detach(nav2_costmap_2d::LayeredCostmap * layered_costmap)
+{
+  if (layered_costmap != layered_costmap_) {
+    return;
+  }
+  std::unique_lock<nav2_costmap_2d::Costmap2D::mutex_t> lock(
+    *(layered_costmap_->getCostmap()->getMutex()));
+  auto & plugins = *layered_costmap_->getPlugins();
+  plugins.erase(
+    std::remove_if(
+      plugins.begin(), plugins.end(),
+      [this](const std::shared_ptr<nav2_costmap_2d::Layer> & plugin) {
+        return plugin.get() == this;
+      }),
+    plugins.end());
+}
+
+void UpdatedCellsLayer::reset()
+{
+  const nav2_costmap_2d::Costmap2D * costmap = layered_costmap_->getCostmap();
+  callback_(0, 0, costmap->getSizeInCellsX(), costmap->getSizeInCellsY());
+}
+
+void UpdatedCellsLayer::updateCosts(
+  nav2_costmap_2d::Costmap2D &, int min_i, int min_j, int max_i, int max_j)
+{
+  if (min_i < max_i && min_j < max_j) {
+    callback_(
+      static_cast<unsigned int>(std::max(min_i, 0)), static_cast<unsigned int>(std::max(min_j, 0)),
+      static_cast<unsigned int>(max_i), static_cast<unsigned int>(max_j));
+  }
+}
+
+void UpdatedCellsLayer::matchSize()
+{
+  reset();
+}
+
+}  // namespace nav2_straightline_planner
@@ -0,0 +1,130 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "nav2_straightline_planner/velocity_profile.hpp"
+
+namespace nav2_straightline_planner
+{
+
+double speedLimitFromMask(
+  signed char mask_value, double base, double multiplier,
+  bool in_percent, double max_velocity)
+{
+  // Same semantics as SPEED_MASK_UNKNOWN and SPEED_MASK_NO_LIMIT of the SpeedFilter
+  if (mask_value <= 0) {
+    return max_velocity;
+  }
+
+  // Like the SpeedFilter, a zero or out of range limit means "no limit", not a stop
+  double limit = base + multiplier * mask_value;
+  if (in_percent) {
+    if (limit > 100.0) {
+      return max_velocity;
+    }
+    limit *= max_velocity / 100.0;
+  }
+  return limit > 0.0 ? std::min(limit, max_velocity) : max_velocity;
+}
+
+void VelocityProfile::reset(double max_acceleration)
+{
+  max_acceleration_ = max_acceleration;
+  distances_.clear();
+  velocities_.clear();
+  times_.clear();
+}
+
+void VelocityProfile::addSample(double ds, double speed_cap)
+{
+  // A non-positive acceleration limit means the speed caps are reached instantly
+  const bool unlimited = max_acceleration_ <= 0.0;
+
+  if (velocities_.empty()) {
+    // Path starts at rest
+    distances_.push_back(0.0);
+    velocities_.push_back(unlimited ? speed_cap : 0.0);
+    return;
+  }
+
+  if (unlimited) {
+    distances_.push_back(ds);
+    velocities_.push_back(speed_cap);
+    return;
+  }
+
+  // Forward pass: the fastest speed reachable from the previous sample
+  const double v_prev = velocities_.back();
+  double v = std::sqrt(v_prev * v_prev + 2.0 * max_acceleration_ * ds);
+  distances_.push_back(ds);
+  velocities_.push_back(std::min(v, speed_cap));
+}
+
+double VelocityProfile::finalize()
+{
+  const size_t n = velocities_.size();
+  times_.assign(n, 0.0);
+  if (n < 2) {
+    return 0.0;
+  }
+
+  // Backward pass: the path ends at rest, so decelerate in time for every cap
+  if (max_acceleration_ > 0.0) {
+    velocities_[n - 1] = 0.0;
+    for (size_t i = n - 1; i > 0; --i) {
+      const double v_next = velocities_[i];
+      const double v = std::sqrt(v_next * v_next + 2.0 * max_acceleration_ * distances_[i]);
+      velocities_[i - 1] = std::min(velocities_[i - 1], v);
+    }
+  }
+
+  // Constant acceleration between samples: dt = 2 * ds / (v0 + v1)
+  for (size_t i = 1; i < n; ++i) {
+    const double v_sum = velocities_[i - 1] + velocities_[i];
+    double dt = 0.0;
+    if (distances_[i] > 0.0) {
+      dt = v_sum > 0.0 ? 2.0 * distances_[i] / v_sum : std::numeric_limits<double>::infinity();
+    }
+    times_[i] = times_[i - 1] + dt;
+  }
+
+  return times_.back();
+}
+
+}  // namespace nav2_straightline_planner
@@ -0,0 +1,160 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_straightline_planner/cost_pyramid.hpp"
+
+using nav2_straightline_planner::CostPyramid;
+
+namespace
+{
+
+std::vector<unsigned char> randomGrid(std::mt19937 & random, unsigned int size)
+{
+  std::uniform_int_distribution<int> cost(0, 299);
+  std::vector<unsigned char> costs(size);
+  for (auto & c : costs) {
+    const int value = cost(random);
+    c = value >= 255 ? nav2_costmap_2d::NO_INFORMATION : static_cast<unsigned char>(value);
+  }
+  return costs;
+}
+
+// Dense reference of a pyramid block: highest cost of its grid cells, unknown cells and
+// cells past the grid edges read as unknown_cost
+unsigned char bruteBlockMax(
+  const std::vector<unsigned char> & costs, unsigned int size_x, unsigned int size_y,
+  unsigned int block_size, unsigned int bx, unsigned int by, unsigned char unknown_cost)
+{
+  unsigned char max_cost = 0;
+  for (unsigned int y = by * block_size; y < (by + 1) * block_size; ++y) {
+    for (unsigned int x = bx * block_size; x < (bx + 1) * block_size; ++x) {
+      unsigned char cost = unknown_cost;
+      if (x < size_x && y < size_y && costs[y * size_x + x] != nav2_costmap_2d::NO_INFORMATION) {
+        cost = costs[y * size_x + x];
+      }
+      max_cost = std::max(max_cost, cost);
+    }
+  }
+  return max_cost;
+}
+
+void expectSamePyramids(const CostPyramid & a, const CostPyramid & b)
+{
+  ASSERT_EQ(a.levels(), b.levels());
+  for (unsigned int level = 1; level <= a.levels(); ++level) {
+    ASSERT_EQ(a.sizeX(level), b.sizeX(level));
+    ASSERT_EQ(a.sizeY(level), b.sizeY(level));
+    for (unsigned int y = 0; y < a.sizeY(level); ++y) {
+      for (unsigned int x = 0; x < a.sizeX(level); ++x) {
+        ASSERT_EQ(a.blockMax(level, x, y), b.blockMax(level, x, y))
+          << "level " << level << " block " << x << ", " << y;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(CostPyramid, RebuildMatchesBruteForce)
+{
+  std::mt19937 random(4);
+  std::uniform_int_distribution<unsigned int> size(1, 150);
+  for (int grid = 0; grid < 50; ++grid) {
+    const unsigned int size_x = size(random), size_y = size(random);
+    const auto costs = randomGrid(random, size_x * size_y);
+    for (unsigned char unknown_cost :
+      {nav2_costmap_2d::FREE_SPACE, nav2_costmap_2d::NO_INFORMATION})
+    {
+      CostPyramid pyramid;
+      pyramid.configure(3, unknown_cost);
+      pyramid.rebuild(costs.data(), size_x, size_y);
+      ASSERT_EQ(pyramid.levels(), 3u);
+      for (unsigned int level = 1; level <= pyramid.levels(); ++level) {
+        const unsigned int block_size = pyramid.blockSize(level);
+        for (unsigned int y = 0; y < pyramid.sizeY(level); ++y) {
+          for (unsigned int x = 0; x < pyramid.sizeX(level); ++x) {
+            ASSERT_EQ(
+              pyramid.blockMax(level, x, y),
+              bruteBlockMax(costs, size_x, size_y, block_size, x, y, unknown_cost))
+              << "level " << level << " block " << x << ", " << y;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(CostPyramid, UpdateMatchesRebuild)
+{
+  std::mt19937 random(5);
+  std::uniform_int_distribution<unsigned int> size(1, 150);
+  std::uniform_int_distribution<int> cost(0, 255);
+  for (int grid = 0; grid < 50; ++grid) {
+    const unsigned int size_x = size(random), size_y = size(random);
+    auto costs = randomGrid(random, size_x * size_y);
+    CostPyramid updated, rebuilt;
+    updated.configure(3, nav2_costmap_2d::NO_INFORMATION);
+    rebuilt.configure(3, nav2_costmap_2d::NO_INFORMATION);
+    updated.rebuild(costs.data(), size_x, size_y);
+
+    for (int change = 0; change < 20; ++change) {
+      // Rewrites a random window, then pools it again
+      const unsigned int min_x = random() % size_x, max_x = min_x + 1 + random() % (size_x - min_x);
+      const unsigned int min_y = random() % size_y, max_y = min_y + 1 + random() % (size_y - min_y);
+      for (unsigned int y = min_y; y < max_y; ++y) {
+        for (unsigned int x = min_x; x < max_x; ++x) {
+          costs[y * size_x + x] = static_cast<unsigned char>(cost(random));
+        }
+      }
+      updated.update(costs.data(), size_x, size_y, min_x, min_y, max_x, max_y);
+      rebuilt.rebuild(costs.data(), size_x, size_y);
+      expectSamePyramids(updated, rebuilt);
+    }
+
+    // A resized grid is pooled from scratch
+    const unsigned int resized_x = size(random), resized_y = size(random);
+    costs = randomGrid(random, resized_x * resized_y);
+    updated.update(costs.data(), resized_x, resized_y, 0, 0, 1, 1);
+    rebuilt.rebuild(costs.data(), resized_x, resized_y);
+    expectSamePyramids(updated, rebuilt);
+  }
+}
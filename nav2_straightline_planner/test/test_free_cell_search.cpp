@@ -0,0 +1,94 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <vector>
+
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_straightline_planner/free_cell_search.hpp"
+
+using nav2_straightline_planner::FreeCellSearch;
+
+TEST(FreeCellSearch, MatchesBruteForce)
+{
+  std::mt19937 random(6);
+  const unsigned char threshold = nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE;
+  FreeCellSearch search;
+  for (int trial = 0; trial < 20000; ++trial) {
+    const unsigned int size_x = 1 + random() % 30, size_y = 1 + random() % 30;
+    // From nearly free to nearly blocked grids
+    const unsigned int free_permille = random() % 1000;
+    std::vector<unsigned char> costs(size_x * size_y);
+    for (auto & cost : costs) {
+      const unsigned int c = random() % 1000;
+      cost = c < free_permille ? nav2_costmap_2d::FREE_SPACE :
+        c % 2 ? nav2_costmap_2d::LETHAL_OBSTACLE : nav2_costmap_2d::NO_INFORMATION;
+    }
+    const bool allow_unknown = random() % 2;
+    const int max_radius = random() % 8;
+    // The search storage is reused across radii, as by the planner
+    search.configure(max_radius);
+    const unsigned int x = random() % size_x, y = random() % size_y;
+    unsigned int free_x, free_y;
+    const bool found = search.find(
+      costs.data(), size_x, size_y, x, y, threshold, allow_unknown, free_x, free_y);
+
+    // Smallest squared distance to a free cell within max_radius
+    int best = INT_MAX;
+    for (unsigned int j = 0; j < size_y; ++j) {
+      for (unsigned int i = 0; i < size_x; ++i) {
+        const unsigned char cost = costs[j * size_x + i];
+        const bool free = cost == nav2_costmap_2d::NO_INFORMATION ? allow_unknown :
+          cost < threshold;
+        const int dx = static_cast<int>(i) - static_cast<int>(x);
+        const int dy = static_cast<int>(j) - static_cast<int>(y);
+        if (free && dx * dx + dy * dy <= max_radius * max_radius) {
+          best = std::min(best, dx * dx + dy * dy);
+        }
+      }
+    }
+    ASSERT_EQ(found, best != INT_MAX) << "trial " << trial;
+    if (found) {
+      const int dx = static_cast<int>(free_x) - static_cast<int>(x);
+      const int dy = static_cast<int>(free_y) - static_cast<int>(y);
+      // Ties between cells at the same distance may go either way
+      ASSERT_EQ(dx * dx + dy * dy, best) << "trial " << trial;
+    }
+  }
+}
@@ -0,0 +1,281 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026 navigation2_tutorials contributors
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Willow Garage, Inc. nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "geometry_msgs/msg/point.hpp"
+#include "nav2_costmap_2d/cost_values.hpp"
+#include "nav2_straightline_planner/cost_pyramid.hpp"
+#include "nav2_straightline_planner/costmap_snapshot.hpp"
+#include "nav2_straightline_planner/segment_collision_checker.hpp"
+
+using nav2_straightline_planner::CellSpan;
+using nav2_straightline_planner::CostPyramid;
+using nav2_straightline_planner::CostmapSnapshot;
+using nav2_straightline_planner::SegmentCollisionChecker;
+
+namespace
+{
+
+constexpr unsigned int SIZE_X = 90;
+constexpr unsigned int SIZE_Y = 70;
+constexpr double RESOLUTION = 0.05;
+constexpr double ORIGIN_X = -1.0;
+constexpr double ORIGIN_Y = -2.0;
+constexpr unsigned char THRESHOLD = nav2_costmap_2d::INSCRIBED_INFLATED_OBSTACLE;
+
+// Sparse random obstacles and unknown cells, so that most segments are free
+std::vector<unsigned char> randomGrid(std::mt19937 & random)
+{
+  std::uniform_int_distribution<int> cell(0, 999);
+  const int obstacles = std::uniform_int_distribution<int>(0, 5)(random);
+  std::vector<unsigned char> costs(SIZE_X * SIZE_Y);
+  for (auto & cost : costs) {
+    const int c = cell(random);
+    cost = c < obstacles ? nav2_costmap_2d::LETHAL_OBSTACLE :
+      c < 2 * obstacles ? nav2_costmap_2d::NO_INFORMATION : static_cast<unsigned char>(c % 200);
+  }
+  return costs;
+}
+
+bool cellBlocks(const std::vector<unsigned char> & costs, int x, int y, bool allow_unknown)
+{
+  if (x < 0 || y < 0 || x >= static_cast<int>(SIZE_X) || y >= static_cast<int>(SIZE_Y)) {
+    return !allow_unknown;
+  }
+  const unsigned char cost = costs[y * SIZE_X + x];
+  if (cost == nav2_costmap_2d::NO_INFORMATION) {
+    return !allow_unknown;
+  }
+  return cost >= THRESHOLD;
+}
+
+// Whether the segment, in grid coordinates, crosses the interior of the cell (x, y)
+bool crossesCell(double x0, double y0, double x1, double y1, int x, int y)
+{
+  // Liang-Barsky clipping against the open cell square
+  double t0 = 0.0, t1 = 1.0;
+  const double p[4] = {-(x1 - x0), x1 - x0, -(y1 - y0), y1 - y0};
+  const double q[4] = {x0 - x, x + 1 - x0, y0 - y, y + 1 - y0};
+  for (int i = 0; i < 4; ++i) {
+    if (p[i] == 0.0) {
+      if (q[i] <= 0.0) {
+        return false;
+      }
+    } else if (p[i] < 0.0) {
+      t0 = std::max(t0, q[i] / p[i]);
+    } else {
+      t1 = std::min(t1, q[i] / p[i]);
+    }
+  }
+  return t0 < t1;
+}
+
+// Dense reference of lineCollides(): any cell crossed by the segment blocks
+bool bruteLineCollides(
+  const std::vector<unsigned char> & costs, bool allow_unknown,
+  double wx0, double wy0, double wx1, double wy1)
+{
+  const double x0 = (wx0 - ORIGIN_X) / RESOLUTION, y0 = (wy0 - ORIGIN_Y) / RESOLUTION;
+  const double x1 = (wx1 - ORIGIN_X) / RESOLUTION, y1 = (wy1 - ORIGIN_Y) / RESOLUTION;
+  for (int y = static_cast<int>(std::floor(std::min(y0, y1)));
+    y <= static_cast<int>(std::floor(std::max(y0, y1))); ++y)
+  {
+    for (int x = static_cast<int>(std::floor(std::min(x0, x1)));
+      x <= static_cast<int>(std::floor(std::max(x0, x1))); ++x)
+    {
+      if (crossesCell(x0, y0, x1, y1, x, y) && cellBlocks(costs, x, y, allow_unknown)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::vector<geometry_msgs::msg::Point> rectangle(double front, double back, double half_width)
+{
+  std::vector<geometry_msgs::msg::Point> footprint(4);
+  footprint[0].x = front;
+  footprint[0].y = half_width;
+  footprint[1].x = -back;
+  footprint[1].y = half_width;
+  footprint[2].x = -back;
+  footprint[2].y = -half_width;
+  footprint[3].x = front;
+  footprint[3].y = -half_width;
+  return footprint;
+}
+
+// Cells under the rectangle footprint at (wx, wy) facing yaw, sampled densely
+void markFootprint(
+  double wx, double wy, double yaw, double front, double back, double half_width,
+  std::set<std::pair<int, int>> & cells)
+{
+  const int samples = 30;
+  for (int i = 0; i <= samples; ++i) {
+    for (int j = 0; j <= samples; ++j) {
+      const double px = -back + (front + back) * i / samples;
+      const double py = -half_width + 2.0 * half_width * j / samples;
+      const double x = wx + px * std::cos(yaw) - py * std::sin(yaw);
+      const double y = wy + px * std::sin(yaw) + py * std::cos(yaw);
+      cells.emplace(
+        static_cast<int>(std::floor((x - ORIGIN_X) / RESOLUTION)),
+        static_cast<int>(std::floor((y - ORIGIN_Y) / RESOLUTION)));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SegmentCollisionChecker, LineCollidesMatchesBruteForce)
+{
+  std::mt19937 random(1);
+  // Ends partly out of the grid, to check its edges too
+  std::uniform_real_distribution<double> wx(ORIGIN_X - 0.3, ORIGIN_X + SIZE_X * RESOLUTION + 0.3);
+  std::uniform_real_distribution<double> wy(ORIGIN_Y - 0.3, ORIGIN_Y + SIZE_Y * RESOLUTION + 0.3);
+  for (int grid = 0; grid < 20; ++grid) {
+    const auto costs = randomGrid(random);
+    for (bool allow_unknown : {false, true}) {
+      CostPyramid pyramid;
+      pyramid.configure(
+        2, allow_unknown ? nav2_costmap_2d::FREE_SPACE : nav2_costmap_2d::NO_INFORMATION);
+      pyramid.rebuild(costs.data(), SIZE_X, SIZE_Y);
+      SegmentCollisionChecker checker;
+      checker.setCostThreshold(THRESHOLD, allow_unknown);
+      checker.setGrid(costs.data(), SIZE_X, SIZE_Y, RESOLUTION, ORIGIN_X, ORIGIN_Y);
+      for (int segment = 0; segment < 200; ++segment) {
+        const double x0 = wx(random), y0 = wy(random), x1 = wx(random), y1 = wy(random);
+        const bool expected = bruteLineCollides(costs, allow_unknown, x0, y0, x1, y1);
+        checker.setPyramid(nullptr);
+        EXPECT_EQ(checker.lineCollides(x0, y0, x1, y1), expected);
+        checker.setPyramid(&pyramid);
+        EXPECT_EQ(checker.lineCollides(x0, y0, x1, y1), expected);
+      }
+    }
+  }
+}
+
+TEST(SegmentCollisionChecker, SweepFootprintCoversTheSweptArea)
+{
+  std::mt19937 random(2);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  SegmentCollisionChecker checker;
+  checker.setGrid(nullptr, SIZE_X, SIZE_Y, RESOLUTION, ORIGIN_X, ORIGIN_Y);
+  for (int sweep = 0; sweep < 500; ++sweep) {
+    const double front = 0.1 + 0.2 * std::abs(unit(random));
+    const double back = 0.1 + 0.2 * std::abs(unit(random));
+    const double half_width = 0.05 + 0.15 * std::abs(unit(random));
+    const double x0 = 1.0 + unit(random), y0 = unit(random);
+    // Some segments of zero length, only turning in place
+    const double x1 = sweep % 10 == 0 ? x0 : 1.0 + unit(random);
+    const double y1 = sweep % 10 == 0 ? y0 : unit(random);
+    const double start_yaw = M_PI * unit(random);
+    checker.sweepFootprint(x0, y0, x1, y1, start_yaw, rectangle(front, back, half_width));
+
+    std::set<std::pair<int, int>> swept;
+    int last_row = -1000000;
+    for (const CellSpan & span : checker.spans()) {
+      // One span per row in increasing row order, as CostmapSnapshot expects
+      ASSERT_GT(span.row, last_row);
+      last_row = span.row;
+      for (int x = span.min_x; x <= span.max_x; ++x) {
+        swept.emplace(x, span.row);
+      }
+    }
+
+    // Turning in place at the start, then translating along the segment
+    const double yaw = x0 == x1 && y0 == y1 ? start_yaw : std::atan2(y1 - y0, x1 - x0);
+    const double turn = std::remainder(yaw - start_yaw, 2.0 * M_PI);
+    std::set<std::pair<int, int>> expected;
+    for (int i = 0; i <= 60; ++i) {
+      markFootprint(x0, y0, start_yaw + turn * i / 60, front, back, half_width, expected);
+    }
+    for (int i = 0; i <= 60; ++i) {
+      markFootprint(
+        x0 + (x1 - x0) * i / 60, y0 + (y1 - y0) * i / 60, yaw, front, back, half_width,
+        expected);
+    }
+    for (const auto & cell : expected) {
+      EXPECT_EQ(swept.count(cell), 1u) << "cell " << cell.first << ", " << cell.second;
+    }
+  }
+}
+
+TEST(SegmentCollisionChecker, SpansCollideMatchesBruteForce)
+{
+  std::mt19937 random(3);
+  std::uniform_real_distribution<double> wx(ORIGIN_X - 0.3, ORIGIN_X + SIZE_X * RESOLUTION + 0.3);
+  std::uniform_real_distribution<double> wy(ORIGIN_Y - 0.3, ORIGIN_Y + SIZE_Y * RESOLUTION + 0.3);
+  std::uniform_real_distribution<double> random_yaw(-M_PI, M_PI);
+  const auto footprint = rectangle(0.15, 0.1, 0.08);
+  for (int grid = 0; grid < 20; ++grid) {
+    const auto costs = randomGrid(random);
+    for (bool allow_unknown : {false, true}) {
+      CostPyramid pyramid;
+      pyramid.configure(
+        2, allow_unknown ? nav2_costmap_2d::FREE_SPACE : nav2_costmap_2d::NO_INFORMATION);
+      pyramid.rebuild(costs.data(), SIZE_X, SIZE_Y);
+      SegmentCollisionChecker checker;
+      checker.setCostThreshold(THRESHOLD, allow_unknown);
+      checker.setGrid(costs.data(), SIZE_X, SIZE_Y, RESOLUTION, ORIGIN_X, ORIGIN_Y);
+      CostmapSnapshot snapshot;
+      for (int segment = 0; segment < 100; ++segment) {
+        checker.sweepFootprint(
+          wx(random), wy(random), wx(random), wy(random), random_yaw(random), footprint);
+        bool expected = false;
+        for (const CellSpan & span : checker.spans()) {
+          for (int x = span.min_x; x <= span.max_x; ++x) {
+            expected = expected || cellBlocks(costs, x, span.row, allow_unknown);
+          }
+        }
+        checker.setPyramid(nullptr);
+        EXPECT_EQ(checker.spansCollide(), expected);
+        checker.setPyramid(&pyramid);
+        EXPECT_EQ(checker.spansCollide(), expected);
+        snapshot.capture(costs.data(), SIZE_X, SIZE_Y, checker.spans());
+        checker.setSnapshot(&snapshot);
+        EXPECT_EQ(checker.spansCollide(), expected);
+        checker.setSnapshot(nullptr);
+      }
+    }
+  }
+}